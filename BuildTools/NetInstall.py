@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+
+# Goldleaf - Nintendo Switch homebrew multitool, for several purposes and with several features
+# Copyright 2018 - 2019 Goldleaf project, developed by XorTroll
+# This project is under the terms of GPLv3 license: https://github.com/XorTroll/Goldleaf/blob/master/LICENSE
+
+# Serves a directory to Goldleaf's network drive browser (see gleaf::fs::HTTPExplorer)
+# Like "python3 -m http.server", but with the keep-alive and byte range support installs stream through
+
+import http.server
+import os
+import re
+import shutil
+import socketserver
+import sys
+
+class RangeRequestHandler(http.server.SimpleHTTPRequestHandler):
+    protocol_version = 'HTTP/1.1'
+
+    def send_head(self):
+        path = self.translate_path(self.path)
+        if os.path.isdir(path):
+            return super().send_head()
+        try:
+            f = open(path, 'rb')
+        except OSError:
+            self.send_error(404, 'File not found')
+            return None
+        size = os.fstat(f.fileno()).st_size
+        start, end = 0, size - 1
+        rng = self.headers.get('Range')
+        m = re.match(r'bytes=(\d*)-(\d*)$', rng.strip()) if rng else None
+        if m and (m.group(1) or m.group(2)):
+            if m.group(1):
+                start = int(m.group(1))
+                if m.group(2):
+                    end = min(int(m.group(2)), size - 1)
+            else:
+                start = max(0, size - int(m.group(2)))
+            if start >= size or start > end:
+                f.close()
+                self.send_response(416)
+                self.send_header('Content-Range', 'bytes */%d' % size)
+                self.send_header('Content-Length', '0')
+                self.end_headers()
+                return None
+            self.send_response(206)
+            self.send_header('Content-Range', 'bytes %d-%d/%d' % (start, end, size))
+        else:
+            self.send_response(200)
+        self.send_header('Content-Type', self.guess_type(path))
+        self.send_header('Accept-Ranges', 'bytes')
+        self.send_header('Content-Length', str(end - start + 1))
+        self.end_headers()
+        f.seek(start)
+        self.remaining = end - start + 1
+        return f
+
+    def copyfile(self, source, outputfile):
+        left = getattr(self, 'remaining', None)
+        if left is None:
+            shutil.copyfileobj(source, outputfile)
+            return
+        while left > 0:
+            chunk = source.read(min(left, 0x100000))
+            if not chunk:
+                break
+            outputfile.write(chunk)
+            left -= len(chunk)
+
+class ThreadedServer(socketserver.ThreadingMixIn, http.server.HTTPServer):
+    daemon_threads = True
+    allow_reuse_address = True
+
+if __name__ == '__main__':
+    if len(sys.argv) not in (2, 3):
+        print('Usage: NetInstall.py <directory> [port]')
+        sys.exit(1)
+    root = os.path.abspath(sys.argv[1])
+    port = int(sys.argv[2]) if len(sys.argv) == 3 else 8000
+    handler = lambda *args, **kwargs: RangeRequestHandler(*args, directory=root, **kwargs)
+    with ThreadedServer(('', port), handler) as server:
+        print('Serving %s on port %d' % (root, port))
+        server.serve_forever()
@@ -0,0 +1,33 @@
+#!/usr/bin/env python3
+
+# Goldleaf - Nintendo Switch homebrew multitool, for several purposes and with several features
+# Copyright 2018 - 2019 Goldleaf project, developed by XorTroll
+# This project is under the terms of GPLv3 license: https://github.com/XorTroll/Goldleaf/blob/master/LICENSE
+
+# Compiles a language JSON array into Goldleaf's binary string table (see gleaf::set::Strings)
+# Layout: "GLST" magic, u32 count, (count + 1) u32 offsets into the data block, then NUL-terminated UTF-8 strings
+
+import json
+import struct
+import sys
+
+def compile_table(src, dst):
+    with open(src, 'r', encoding='utf-8') as f:
+        strings = json.load(f)
+    data = bytearray()
+    offsets = []
+    for s in strings:
+        offsets.append(len(data))
+        data += s.encode('utf-8') + b'\0'
+    offsets.append(len(data))
+    with open(dst, 'wb') as f:
+        f.write(b'GLST')
+        f.write(struct.pack('<I', len(strings)))
+        f.write(struct.pack('<%dI' % len(offsets), *offsets))
+        f.write(data)
+
+if __name__ == '__main__':
+    if len(sys.argv) != 3:
+        print('Usage: StringTable.py <input.json> <output.bin>')
+        sys.exit(1)
+    compile_table(sys.argv[1], sys.argv[2])
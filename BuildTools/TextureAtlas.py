@@ -0,0 +1,121 @@
+#!/usr/bin/env python3
+
+# Goldleaf - Nintendo Switch homebrew multitool, for several purposes and with several features
+# Copyright 2018 - 2019 Goldleaf project, developed by XorTroll
+# This project is under the terms of GPLv3 license: https://github.com/XorTroll/Goldleaf/blob/master/LICENSE
+
+# Packs Goldleaf's small RomFs icons into one PNG plus an index (see gleaf::ui::IconAtlas)
+# Index layout: "GLAT" magic, u32 count, then per icon a 0x40-byte NUL-padded RomFs path and u16 x, y, width, height
+
+import os
+import struct
+import sys
+import zlib
+
+ATLAS_WIDTH = 1024
+PADDING = 1
+
+def read_png(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+    if data[:8] != b'\x89PNG\r\n\x1a\n':
+        raise ValueError(path + ': not a PNG file')
+    pos = 8
+    idat = b''
+    width = height = depth = ctype = interlace = 0
+    while pos < len(data):
+        size, kind = struct.unpack('>I4s', data[pos:pos + 8])
+        chunk = data[pos + 8:pos + 8 + size]
+        if kind == b'IHDR':
+            width, height, depth, ctype, _, _, interlace = struct.unpack('>IIBBBBB', chunk)
+        elif kind == b'IDAT':
+            idat += chunk
+        pos += size + 12
+    if depth != 8 or ctype not in (2, 6) or interlace != 0:
+        raise ValueError(path + ': only non-interlaced 8-bit RGB/RGBA PNGs are supported')
+    bpp = 4 if ctype == 6 else 3
+    raw = zlib.decompress(idat)
+    stride = width * bpp
+    rows = []
+    prev = bytearray(stride)
+    pos = 0
+    for _ in range(height):
+        ftype = raw[pos]
+        line = bytearray(raw[pos + 1:pos + 1 + stride])
+        pos += stride + 1
+        for i in range(stride):
+            a = line[i - bpp] if i >= bpp else 0
+            b = prev[i]
+            c = prev[i - bpp] if i >= bpp else 0
+            if ftype == 1:
+                line[i] = (line[i] + a) & 0xff
+            elif ftype == 2:
+                line[i] = (line[i] + b) & 0xff
+            elif ftype == 3:
+                line[i] = (line[i] + ((a + b) >> 1)) & 0xff
+            elif ftype == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                pred = a if (pa <= pb and pa <= pc) else (b if pb <= pc else c)
+                line[i] = (line[i] + pred) & 0xff
+        prev = line
+        if bpp == 3:
+            rgba = bytearray()
+            for i in range(width):
+                rgba += line[i * 3:i * 3 + 3] + b'\xff'
+            line = rgba
+        rows.append(bytes(line))
+    return width, height, rows
+
+def write_png(path, width, height, pixels):
+    def chunk(kind, body):
+        return struct.pack('>I', len(body)) + kind + body + struct.pack('>I', zlib.crc32(kind + body) & 0xffffffff)
+    raw = b''.join(b'\0' + bytes(pixels[y * width * 4:(y + 1) * width * 4]) for y in range(height))
+    with open(path, 'wb') as f:
+        f.write(b'\x89PNG\r\n\x1a\n')
+        f.write(chunk(b'IHDR', struct.pack('>IIBBBBB', width, height, 8, 6, 0, 0, 0)))
+        f.write(chunk(b'IDAT', zlib.compress(raw, 9)))
+        f.write(chunk(b'IEND', b''))
+
+def pack(romfs, dirs, out_png, out_idx):
+    icons = []
+    for d in dirs:
+        for name in sorted(os.listdir(os.path.join(romfs, d))):
+            if name.lower().endswith('.png'):
+                rel = d + '/' + name
+                icons.append((rel,) + read_png(os.path.join(romfs, rel)))
+    icons.sort(key=lambda icon: -icon[2])
+    x = y = rowh = 0
+    places = []
+    for rel, w, h, rows in icons:
+        if x + w > ATLAS_WIDTH:
+            x = 0
+            y += rowh
+            rowh = 0
+        places.append((rel, x, y, w, h, rows))
+        x += w + PADDING
+        rowh = max(rowh, h + PADDING)
+    height = 1
+    while height < y + rowh:
+        height *= 2
+    pixels = bytearray(ATLAS_WIDTH * height * 4)
+    for rel, px, py, w, h, rows in places:
+        for r in range(h):
+            off = ((py + r) * ATLAS_WIDTH + px) * 4
+            pixels[off:off + w * 4] = rows[r]
+    write_png(out_png, ATLAS_WIDTH, height, pixels)
+    with open(out_idx, 'wb') as f:
+        f.write(b'GLAT')
+        f.write(struct.pack('<I', len(places)))
+        for rel, px, py, w, h, _ in places:
+            name = rel.encode('utf-8')
+            if len(name) >= 0x40:
+                raise ValueError(rel + ': path too long for the atlas index')
+            f.write(name.ljust(0x40, b'\0'))
+            f.write(struct.pack('<4H', px, py, w, h))
+
+if __name__ == '__main__':
+    if len(sys.argv) < 5:
+        print('Usage: TextureAtlas.py <romfs dir> <output.png> <output.idx> <icon dir>...')
+        sys.exit(1)
+    pack(sys.argv[1], sys.argv[4:], sys.argv[2], sys.argv[3])
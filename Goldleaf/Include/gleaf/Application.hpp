@@ -18,6 +18,8 @@ namespace gleaf
     void Initialize();
     void Finalize();
     void EnsureDirectories();
+    void TraceStartup(std::string Step);
+    void SaveStartupTrace();
     RunMode GetRunMode();
     bool IsNRO();
     bool IsInstalledTitle();
@@ -0,0 +1,61 @@
+
+/*
+
+    Goldleaf - Nintendo Switch homebrew multitool, for several purposes and with several features
+
+    Copyright 2018 - 2019 Goldleaf project, developed by XorTroll
+    This project is under the terms of GPLv3 license: https://github.com/XorTroll/Goldleaf/blob/master/LICENSE
+
+*/
+
+#pragma once
+#include <switch.h>
+#include <string>
+#include <atomic>
+#include <memory>
+#include <functional>
+#include <gleaf/Progress.hpp>
+
+namespace gleaf
+{
+    enum class JobState
+    {
+        Queued,
+        Running,
+        Finished,
+        Cancelled,
+    };
+
+    // Work runs on the job worker: it must not touch the UI, only its own Progress and status text
+    class Job
+    {
+        public:
+            Job(std::string Name, std::function<Result(Job &Self)> Work);
+            std::string GetName();
+            JobState GetState();
+            bool IsDone();
+            Result GetResult();
+            Progress &GetProgress();
+            void SetStatus(std::string Status);
+            std::string GetStatus();
+            void Cancel();
+            void Pause();
+            void Resume();
+            bool IsPaused();
+            bool IsCancelled();
+            void Run();
+        private:
+            std::string name;
+            std::function<Result(Job&)> work;
+            std::atomic<JobState> state;
+            std::atomic<Result> rc;
+            Progress prog;
+            std::string status;
+            Mutex slock;
+    };
+
+    void StartJobService();
+    void StopJobService();
+    std::shared_ptr<Job> QueueJob(std::string Name, std::function<Result(Job &Self)> Work);
+    u32 GetPendingJobCount();
+}
\ No newline at end of file
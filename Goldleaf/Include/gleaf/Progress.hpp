@@ -0,0 +1,73 @@
+
+/*
+
+    Goldleaf - Nintendo Switch homebrew multitool, for several purposes and with several features
+
+    Copyright 2018 - 2019 Goldleaf project, developed by XorTroll
+    This project is under the terms of GPLv3 license: https://github.com/XorTroll/Goldleaf/blob/master/LICENSE
+
+*/
+
+#pragma once
+#include <switch.h>
+#include <string>
+#include <atomic>
+#include <functional>
+
+namespace gleaf
+{
+    struct ProgressSample
+    {
+        u64 BytesDone;
+        u64 BytesTotal;
+        u32 ItemsDone;
+        u32 ItemsTotal;
+        double Percentage;
+        double Throughput;
+        u64 ETA;
+    };
+
+    // Workers only touch atomics; sampling (throughput smoothing, the callback) happens at most once per interval
+    class Progress
+    {
+        public:
+            Progress();
+            void Reset();
+            void SetTotal(u64 Bytes, u32 Items = 0);
+            void AddTotal(u64 Bytes, u32 Items = 0);
+            void Advance(u64 Bytes);
+            void SetDone(u64 Bytes);
+            void CompleteItem();
+            u64 GetBytesDone();
+            u64 GetBytesTotal();
+            u32 GetItemsDone();
+            u32 GetItemsTotal();
+            void SetOnSample(std::function<void(ProgressSample Sample)> Callback, u64 IntervalMs = 16);
+            ProgressSample Sample();
+            void Flush();
+            void Cancel();
+            bool IsCancelled();
+            void Pause();
+            void Resume();
+            bool IsPaused();
+            // Blocks while paused, false once cancelled: long loops call it between chunks
+            bool CheckPoint();
+        private:
+            void Notify(bool Force);
+            std::atomic<bool> cancel;
+            std::atomic<bool> pause;
+            std::atomic<u64> done;
+            std::atomic<u64> total;
+            std::atomic<u32> idone;
+            std::atomic<u32> itotal;
+            std::atomic<u64> lastcb;
+            u64 interval;
+            std::function<void(ProgressSample)> cb;
+            Mutex slock;
+            u64 sdone;
+            u64 stime;
+            double rate;
+    };
+
+    std::string FormatDuration(u64 Seconds);
+}
\ No newline at end of file
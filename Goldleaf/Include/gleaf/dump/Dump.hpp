@@ -22,7 +22,7 @@ namespace gleaf::dump
         Data,
     };
 
-    void DecryptCopyNAX0ToNCA(NcmContentStorage *ncst, NcmNcaId NCAId, std::string Path, std::function<void(double Done, double Total)> Callback);
+    void DecryptCopyNAX0ToNCA(NcmContentStorage *ncst, NcmNcaId NCAId, std::string Path, Progress &Prog);
     bool GetMetaRecord(NcmContentMetaDatabase *metadb, u64 ApplicationId, NcmMetaRecord *out);
     FsStorageId GetApplicationLocation(u64 ApplicationId);
     std::string GetTitleKeyData(u64 ApplicationId, bool ExportData);
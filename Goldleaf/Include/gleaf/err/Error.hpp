@@ -23,6 +23,10 @@ namespace gleaf::err
         FileDirectoryAlreadyPresent,
         CouldNotLocateTitleContents,
         CouldNotBuildNSP,
+        OperationCancelled,
+        DownloadFailed,
+        ReadFailed,
+        WriteFailed,
     };
 
     struct Error
@@ -10,4 +10,6 @@
 
 #pragma once
 #include <gleaf/fs/Explorer.hpp>
+#include <gleaf/fs/HTTPExplorer.hpp>
+#include <gleaf/fs/FatFsExplorer.hpp>
 #include <gleaf/fs/FS.hpp>
\ No newline at end of file
@@ -0,0 +1,121 @@
+
+/*
+
+    Goldleaf - Nintendo Switch homebrew multitool, for several purposes and with several features
+
+    Copyright 2018 - 2019 Goldleaf project, developed by XorTroll
+    This project is under the terms of GPLv3 license: https://github.com/XorTroll/Goldleaf/blob/master/LICENSE
+
+*/
+
+#pragma once
+#include <gleaf/Types.hpp>
+#include <fatfs/fatfs.hpp>
+#include <unordered_map>
+#include <vector>
+#include <cstdio>
+
+namespace gleaf::fs
+{
+    // Sector-level backend for the bundled FatFs
+    class BlockDevice
+    {
+        public:
+            virtual ~BlockDevice();
+            virtual bool ReadSectors(u64 Sector, u32 Count, u8 *Out) = 0;
+            virtual bool WriteSectors(u64 Sector, u32 Count, const u8 *Data) = 0;
+            virtual bool Flush();
+            virtual u64 GetSectorCount() = 0;
+            virtual u32 GetSectorSize();
+            virtual bool IsReadOnly();
+    };
+
+    // Raw FAT images (.img) on any stdio path: SD card, PC drives, or a plain file when built for a PC
+    class FileBlockDevice : public BlockDevice
+    {
+        public:
+            FileBlockDevice(std::string Path, bool ReadOnly = false);
+            ~FileBlockDevice();
+            bool IsOk();
+            virtual bool ReadSectors(u64 Sector, u32 Count, u8 *Out) override;
+            virtual bool WriteSectors(u64 Sector, u32 Count, const u8 *Data) override;
+            virtual bool Flush() override;
+            virtual u64 GetSectorCount() override;
+            virtual bool IsReadOnly() override;
+        private:
+            FILE *f;
+            u64 sectors;
+            bool ro;
+    };
+
+    class StorageBlockDevice : public BlockDevice
+    {
+        public:
+            StorageBlockDevice(FsStorage *Storage, bool ReadOnly = true);
+            virtual bool ReadSectors(u64 Sector, u32 Count, u8 *Out) override;
+            virtual bool WriteSectors(u64 Sector, u32 Count, const u8 *Data) override;
+            virtual bool Flush() override;
+            virtual u64 GetSectorCount() override;
+            virtual bool IsReadOnly() override;
+        private:
+            FsStorage *stg;
+            u64 sectors;
+            bool ro;
+    };
+
+    struct CacheBlock
+    {
+        u64 Block;
+        u32 Sectors;
+        u64 LastUse;
+        bool Dirty;
+        bool Pinned;
+        u8 *Data;
+    };
+
+    // Blocks of several sectors, read ahead on sequential access and written back on eviction or sync; pinned ranges (the FAT) stay resident
+    class BlockCache
+    {
+        public:
+            BlockCache(BlockDevice *Device, u32 BlockSectors = 64, u32 BlockCount = 64, u32 ReadAhead = 8);
+            ~BlockCache();
+            BlockDevice *GetDevice();
+            bool Read(u64 Sector, u32 Count, u8 *Out);
+            bool Write(u64 Sector, u32 Count, const u8 *Data);
+            bool Flush();
+            void Pin(u64 Sector, u64 Count);
+            u64 GetDeviceReads();
+            u64 GetDeviceWrites();
+        private:
+            CacheBlock *Find(u64 Block);
+            CacheBlock *Load(u64 Block);
+            CacheBlock *Evict();
+            bool WriteBack(CacheBlock *Block);
+            bool IsPinned(u64 Block);
+            BlockDevice *dev;
+            u32 ssize;
+            u32 bsectors;
+            u32 rahead;
+            u64 tick;
+            u64 lastblock;
+            u64 pinstart;
+            u64 pinend;
+            u32 pinned;
+            u64 dreads;
+            u64 dwrites;
+            std::vector<CacheBlock> blocks;
+            std::unordered_map<u64, u32> index;
+            std::vector<u8> pool;
+            std::vector<u8> stage;
+            std::vector<u8> wstage;
+            Mutex lock;
+    };
+
+    // Drive numbers are FatFs's physical drives ("0:", "1:"...); the cache is created and owned here, the device stays owned by the caller
+    bool MountDisk(u8 Drive, BlockDevice *Device);
+    void UnmountDisk(u8 Drive);
+    BlockCache *GetDiskCache(u8 Drive);
+    void PinFATRegion(u8 Drive, FATFS *Volume);
+    // Cluster link map for a file opened for reading, so seeking around big files doesn't walk the FAT chain
+    FRESULT EnableFastSeek(FIL *File, std::vector<DWORD> &Table);
+}
\ No newline at end of file
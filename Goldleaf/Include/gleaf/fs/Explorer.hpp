@@ -17,9 +17,13 @@ namespace gleaf::fs
     class Explorer
     {
         public:
-            ~Explorer();
+            virtual ~Explorer();
             virtual void Close();
             virtual bool ShouldWarnOnWriteAccess();
+            virtual bool IsReadOnly();
+            // Chunked writes: StartFile truncates, WriteFileBlock calls append until EndFile flushes and closes (explorers without handles ignore both)
+            virtual void StartFile(std::string Path);
+            virtual void EndFile();
             void SetNames(std::string MountName, std::string DisplayName);
             bool NavigateBack();
             bool NavigateForward(std::string Path);
@@ -32,14 +36,15 @@ namespace gleaf::fs
             std::string MakeFull(std::string Path);
             bool IsFullPath(std::string Path);
             void CopyFile(std::string Path, std::string NewPath);
-            void CopyFileProgress(std::string Path, std::string NewPath, std::function<void(u8 Percentage)> Callback);
+            Result CopyFileProgress(std::string Path, std::string NewPath, Progress &Prog);
             void CopyDirectory(std::string Dir, std::string NewDir);
-            void CopyDirectoryProgress(std::string Dir, std::string NewDir, std::function<void(u8 Percentage)> Callback);
+            Result CopyDirectoryProgress(std::string Dir, std::string NewDir, Progress &Prog);
             bool IsFileBinary(std::string Path);
             std::vector<u8> ReadFile(std::string Path);
             std::vector<std::string> ReadFileLines(std::string Path, u32 LineOffset, u32 LineCount);
             std::vector<std::string> ReadFileFormatHex(std::string Path, u32 LineOffset, u32 LineCount);
             u64 GetDirectorySize(std::string Path);
+            u32 GetDirectoryFileCount(std::string Path);
             void DeleteDirectory(std::string Path);
 
             virtual std::vector<std::string> GetDirectories(std::string Path) = 0;
@@ -59,6 +64,7 @@ namespace gleaf::fs
             virtual u64 GetTotalSpace() = 0;
             virtual u64 GetFreeSpace() = 0;
         protected:
+            Result CopyDirectoryTree(std::string Dir, std::string NewDir, Progress &Prog, std::vector<std::string> &Created);
             std::string dspname;
             std::string mntname;
             std::string ecwd;
@@ -67,6 +73,10 @@ namespace gleaf::fs
     class StdExplorer : public Explorer
     {
         public:
+            StdExplorer();
+            ~StdExplorer();
+            virtual void StartFile(std::string Path) override;
+            virtual void EndFile() override;
             virtual std::vector<std::string> GetDirectories(std::string Path) override;
             virtual std::vector<std::string> GetFiles(std::string Path) override;
             virtual bool Exists(std::string Path) override;
@@ -83,6 +93,9 @@ namespace gleaf::fs
             virtual u64 GetFileSize(std::string Path) override;
             virtual u64 GetTotalSpace() override;
             virtual u64 GetFreeSpace() override;
+        private:
+            FILE *wfile;
+            std::string wpath;
     };
 
     class SdCardExplorer : public StdExplorer
@@ -148,5 +161,8 @@ namespace gleaf::fs
     Explorer *GetNANDUserExplorer();
     Explorer *GetNANDSystemExplorer();
     Explorer *GetUSBPCDriveExplorer(std::string MountName);
+    Explorer *GetHTTPExplorer(std::string BaseURL);
+    Explorer *GetFatFsImageExplorer(std::string Path, Explorer *Host);
+    void CloseFatFsExplorers();
     Explorer *GetExplorerForMountName(std::string MountName);
 }
\ No newline at end of file
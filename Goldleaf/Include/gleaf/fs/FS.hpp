@@ -13,6 +13,7 @@
 #include <vector>
 #include <functional>
 #include <switch.h>
+#include <gleaf/Progress.hpp>
 
 namespace gleaf::fs
 {
@@ -31,9 +32,9 @@ namespace gleaf::fs
     void CreateFile(std::string Path);
     Result CreateDirectory(std::string Path);
     void CopyFile(std::string Path, std::string NewPath);
-    void CopyFileProgress(std::string Path, std::string NewPath, std::function<void(u8 Percentage)> Callback);
+    Result CopyFileProgress(std::string Path, std::string NewPath, Progress &Prog);
     void CopyDirectory(std::string Dir, std::string NewDir);
-    void CopyDirectoryProgress(std::string Dir, std::string NewDir, std::function<void(u8 Percentage)> Callback);
+    Result CopyDirectoryProgress(std::string Dir, std::string NewDir, Progress &Prog);
     Result DeleteFile(std::string Path);
     Result DeleteDirectory(std::string Path);
     bool IsFileBinary(std::string Path);
@@ -0,0 +1,77 @@
+
+/*
+
+    Goldleaf - Nintendo Switch homebrew multitool, for several purposes and with several features
+
+    Copyright 2018 - 2019 Goldleaf project, developed by XorTroll
+    This project is under the terms of GPLv3 license: https://github.com/XorTroll/Goldleaf/blob/master/LICENSE
+
+*/
+
+#pragma once
+#include <gleaf/fs/Explorer.hpp>
+#include <gleaf/fs/Disk.hpp>
+
+namespace gleaf::fs
+{
+    // Images living behind another explorer (a PC drive, a remote share...), read through that explorer's block reads
+    class ExplorerBlockDevice : public BlockDevice
+    {
+        public:
+            ExplorerBlockDevice(Explorer *Exp, std::string Path);
+            virtual bool ReadSectors(u64 Sector, u32 Count, u8 *Out) override;
+            virtual bool WriteSectors(u64 Sector, u32 Count, const u8 *Data) override;
+            virtual u64 GetSectorCount() override;
+            virtual bool IsReadOnly() override;
+        private:
+            Explorer *exp;
+            std::string path;
+            u64 sectors;
+    };
+
+    // Any FAT12/16/32 or exFAT volume FatFs can mount: USB mass-storage drives or raw disk images, depending on the device given
+    class FatFsExplorer : public Explorer
+    {
+        public:
+            FatFsExplorer(BlockDevice *Device, std::string DisplayName);
+            ~FatFsExplorer();
+            bool IsOk();
+            std::string GetLabel();
+            virtual bool IsReadOnly() override;
+            virtual void StartFile(std::string Path) override;
+            virtual void EndFile() override;
+            virtual std::vector<std::string> GetDirectories(std::string Path) override;
+            virtual std::vector<std::string> GetFiles(std::string Path) override;
+            virtual bool Exists(std::string Path) override;
+            virtual bool IsFile(std::string Path) override;
+            virtual bool IsDirectory(std::string Path) override;
+            virtual void CreateFile(std::string Path) override;
+            virtual void CreateDirectory(std::string Path) override;
+            virtual void RenameFile(std::string Path, std::string NewName) override;
+            virtual void RenameDirectory(std::string Path, std::string NewName) override;
+            virtual void DeleteFile(std::string Path) override;
+            virtual void DeleteDirectorySingle(std::string Path) override;
+            virtual u64 ReadFileBlock(std::string Path, u64 Offset, u64 Size, u8 *Out) override;
+            virtual u64 WriteFileBlock(std::string Path, u8 *Data, u64 Size) override;
+            virtual u64 GetFileSize(std::string Path) override;
+            virtual u64 GetTotalSpace() override;
+            virtual u64 GetFreeSpace() override;
+            virtual void Close() override;
+        private:
+            std::string FatPath(std::string Path);
+            bool IsRoot(std::string Path);
+            void CloseHandles();
+            void SyncWrite();
+            BlockDevice *dev;
+            s32 drive;
+            std::string root;
+            bool ok;
+            FATFS fatfs;
+            FIL rfile;
+            std::string rpath;
+            std::vector<DWORD> rtable;
+            FIL wfile;
+            std::string wpath;
+            Mutex lock;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,73 @@
+
+/*
+
+    Goldleaf - Nintendo Switch homebrew multitool, for several purposes and with several features
+
+    Copyright 2018 - 2019 Goldleaf project, developed by XorTroll
+    This project is under the terms of GPLv3 license: https://github.com/XorTroll/Goldleaf/blob/master/LICENSE
+
+*/
+
+#pragma once
+#include <map>
+#include <gleaf/fs/Explorer.hpp>
+#include <gleaf/horizon/TaskPool.hpp>
+
+namespace gleaf::fs
+{
+    struct HTTPListing
+    {
+        std::vector<std::string> Directories;
+        std::vector<std::string> Files;
+        u64 Timestamp;
+    };
+
+    struct HTTPWindow
+    {
+        std::string URL;
+        u64 Offset;
+        u64 Size;
+        std::vector<u8> Data;
+    };
+
+    // Read-only access to a web server's directory listings (Python's http.server, nginx autoindex...); files are read with range requests
+    class HTTPExplorer : public Explorer
+    {
+        public:
+            HTTPExplorer(std::string BaseURL);
+            ~HTTPExplorer();
+            std::string GetBaseURL();
+            std::string URLFor(std::string Path);
+            virtual bool IsReadOnly() override;
+            virtual std::vector<std::string> GetDirectories(std::string Path) override;
+            virtual std::vector<std::string> GetFiles(std::string Path) override;
+            virtual bool Exists(std::string Path) override;
+            virtual bool IsFile(std::string Path) override;
+            virtual bool IsDirectory(std::string Path) override;
+            virtual void CreateFile(std::string Path) override;
+            virtual void CreateDirectory(std::string Path) override;
+            virtual void RenameFile(std::string Path, std::string NewName) override;
+            virtual void RenameDirectory(std::string Path, std::string NewName) override;
+            virtual void DeleteFile(std::string Path) override;
+            virtual void DeleteDirectorySingle(std::string Path) override;
+            virtual u64 ReadFileBlock(std::string Path, u64 Offset, u64 Size, u8 *Out) override;
+            virtual u64 WriteFileBlock(std::string Path, u8 *Data, u64 Size) override;
+            virtual u64 GetFileSize(std::string Path) override;
+            virtual u64 GetTotalSpace() override;
+            virtual u64 GetFreeSpace() override;
+            virtual void Close() override;
+        private:
+            HTTPListing GetListing(std::string Path);
+            bool FillWindow(HTTPWindow &Window, std::string URL, u64 Offset, u64 Size);
+            void StartPrefetch(std::string URL, u64 Offset, u64 FileSize);
+            std::string base;
+            std::map<std::string, HTTPListing> listings;
+            std::map<std::string, u64> sizes;
+            HTTPWindow cur;
+            HTTPWindow next;
+            horizon::TaskGroup prefetch;
+            std::atomic<bool> cancel;
+            Mutex clock;
+            Mutex rlock;
+    };
+}
\ No newline at end of file
@@ -9,4 +9,6 @@
 */
 
 #pragma once
-#include <gleaf/hactool/Hactool.hpp>
\ No newline at end of file
+#include <gleaf/hactool/Diagnostics.hpp>
+#include <gleaf/hactool/Hactool.hpp>
+#include <gleaf/hactool/NCA.hpp>
\ No newline at end of file
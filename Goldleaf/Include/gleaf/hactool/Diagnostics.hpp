@@ -0,0 +1,28 @@
+
+/*
+
+    Goldleaf - Nintendo Switch homebrew multitool, for several purposes and with several features
+
+    Copyright 2018 - 2019 Goldleaf project, developed by XorTroll
+    This project is under the terms of GPLv3 license: https://github.com/XorTroll/Goldleaf/blob/master/LICENSE
+
+*/
+
+#pragma once
+#include <string>
+#include <switch.h>
+
+namespace gleaf::hactool
+{
+    // hactool reports everything through stdout/stderr, so while capturing both are routed into a memory ring buffer
+    static constexpr u64 DiagnosticsBufferSize = 0x4000;
+
+    void BeginCapture();
+    void EndCapture();
+    void AppendDiagnostics(std::string Line);
+    std::string GetDiagnostics();
+    void ClearDiagnostics();
+    bool FlushDiagnostics(std::string Path);
+    void CloseDiagnostics();
+    std::string GetDiagnosticsPath();
+}
\ No newline at end of file
@@ -72,5 +72,8 @@ namespace gleaf::hactool
     };
 
     std::string NCATypeToString(NCAType NCA);
+    bool LoadKeyset(std::string KeyFile, hactool_settings_t *Settings);
+    bool GetKeyset(std::string KeyFile, nca_keyset_t *Out);
+    void InvalidateKeyset();
     ProcessResult Process(std::string Input, Extraction Mode, ExtractionFormat Format, std::string KeyFile);
 }
\ No newline at end of file
@@ -0,0 +1,82 @@
+
+/*
+
+    Goldleaf - Nintendo Switch homebrew multitool, for several purposes and with several features
+
+    Copyright 2018 - 2019 Goldleaf project, developed by XorTroll
+    This project is under the terms of GPLv3 license: https://github.com/XorTroll/Goldleaf/blob/master/LICENSE
+
+*/
+
+#pragma once
+#include <string>
+#include <vector>
+#include <functional>
+#include <switch.h>
+#include <mbedtls/aes.h>
+#include <gleaf/hactool/Hactool.hpp>
+#include <gleaf/fs/Explorer.hpp>
+
+namespace gleaf::hactool
+{
+    enum class NCASectionCrypto
+    {
+        None = 1,
+        XTS = 2,
+        CTR = 3,
+        BKTR = 4,
+    };
+
+    // Raw (encrypted) reads from wherever the NCA lives: a file, a content storage...
+    typedef std::function<u64(u64 Offset, u64 Size, u8 *Out)> NCAReader;
+
+    // Decryption core, shared by the NCA reader and anything else needing Nintendo's XTS/CTR layout
+    void DecryptXTS(const u8 *Key, u8 *Data, u64 Size, u64 Sector, u64 SectorSize);
+    void DecryptCTR(const mbedtls_aes_context *Context, const u8 *Ctr, u64 Offset, u8 *Data, u64 Size);
+    void DecryptECB(const u8 *Key, u8 *Data, u64 Size);
+
+    struct NCASection
+    {
+        bool Present;
+        u64 Offset;
+        u64 Size;
+        NCASectionCrypto Crypto;
+        u8 FsType;
+        u8 Ctr[0x10];
+    };
+
+    class NCA
+    {
+        public:
+            NCA(NCAReader Reader, nca_keyset_t *Keyset);
+            NCA(std::string Path, fs::Explorer *Exp, nca_keyset_t *Keyset);
+            NCA(NcmContentStorage *Storage, NcmNcaId NCAId, nca_keyset_t *Keyset);
+            ~NCA();
+            bool IsOk();
+            bool HasRightsId();
+            nca_header_t *GetHeader();
+            NCAType GetType();
+            u64 GetApplicationId();
+            u64 GetSize();
+            u8 GetKeyGeneration();
+            bool HasSection(u32 Index);
+            u64 GetSectionSize(u32 Index);
+            NCASectionCrypto GetSectionCrypto(u32 Index);
+            u32 FindRomFsSection();
+            u64 ReadSectionBlock(u32 Index, u64 Offset, u64 Size, u8 *Out);
+        private:
+            void Open(nca_keyset_t *Keyset);
+            void SetSectionKey(const u8 *Key);
+            u64 ReadCTR(NCASection *Section, u64 Offset, u64 Size, u8 *Out);
+            NCAReader reader;
+            nca_header_t header;
+            NCASection sections[4];
+            nca_keyset_t *keys;
+            mbedtls_aes_context aes;
+            u8 keyarea[0x40];
+            u8 seckey[0x10];
+            bool ok;
+            bool rid;
+            bool haskey;
+    };
+}
\ No newline at end of file
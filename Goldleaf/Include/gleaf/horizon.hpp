@@ -9,6 +9,8 @@
 */
 
 #pragma once
+#include <gleaf/horizon/Integrity.hpp>
 #include <gleaf/horizon/Misc.hpp>
 #include <gleaf/horizon/NCAId.hpp>
+#include <gleaf/horizon/TaskPool.hpp>
 #include <gleaf/horizon/Title.hpp>
\ No newline at end of file
@@ -0,0 +1,72 @@
+
+/*
+
+    Goldleaf - Nintendo Switch homebrew multitool, for several purposes and with several features
+
+    Copyright 2018 - 2019 Goldleaf project, developed by XorTroll
+    This project is under the terms of GPLv3 license: https://github.com/XorTroll/Goldleaf/blob/master/LICENSE
+
+*/
+
+#pragma once
+#include <switch.h>
+#include <string>
+#include <vector>
+#include <functional>
+#include <mbedtls/sha256.h>
+#include <gleaf/horizon/Title.hpp>
+
+namespace gleaf::horizon
+{
+    enum class ContentIntegrity
+    {
+        Ok,
+        HashMismatch,
+        ReadError,
+    };
+
+    struct ContentVerification
+    {
+        u64 ApplicationId;
+        ncm::ContentType Type;
+        NcmNcaId NCAId;
+        Storage Location;
+        u64 Size;
+        ContentIntegrity Status;
+    };
+
+    struct IntegrityJob
+    {
+        ContentVerification Content;
+        u8 Hash[0x20];
+        bool HasHash;
+        bool Skip;
+        bool Done;
+        bool Started;
+        bool Running;
+        u64 Offset;
+        mbedtls_sha256_context Sha;
+    };
+
+    class IntegrityScanner
+    {
+        public:
+            IntegrityScanner(std::vector<Title> Titles, u32 Workers = 3);
+            ~IntegrityScanner();
+            std::vector<ContentVerification> Scan(Progress &Prog);
+            void ResetProgress();
+        private:
+            void LoadProgress();
+            void SaveVerified(const NcmNcaId &NCAId);
+            void VerifyChunk(u32 Index);
+            std::vector<Title> titles;
+            std::vector<IntegrityJob> jobs;
+            std::vector<std::string> verified;
+            u32 workers;
+            u64 done;
+            Progress *prog;
+            Mutex lock;
+    };
+
+    std::string GetIntegrityProgressPath();
+}
\ No newline at end of file
@@ -36,7 +36,7 @@ namespace gleaf::horizon
     class Thread
     {
         public:
-            Thread(ThreadFunc Callback);
+            Thread(ThreadFunc Callback, size_t StackSize = 0x2000, int CpuId = -2, int Priority = 0x2b);
             ~Thread();
             Result Start(void *Args = NULL);
             Result Join();
@@ -44,6 +44,10 @@ namespace gleaf::horizon
             Result Resume();
         private:
             ThreadFunc tcb;
+            size_t stacksz;
+            int cpuid;
+            int prio;
+            bool created;
             ::Thread nth;
     };
 
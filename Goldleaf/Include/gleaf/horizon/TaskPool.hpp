@@ -0,0 +1,63 @@
+
+/*
+
+    Goldleaf - Nintendo Switch homebrew multitool, for several purposes and with several features
+
+    Copyright 2018 - 2019 Goldleaf project, developed by XorTroll
+    This project is under the terms of GPLv3 license: https://github.com/XorTroll/Goldleaf/blob/master/LICENSE
+
+*/
+
+#pragma once
+#include <switch.h>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <functional>
+
+namespace gleaf::horizon
+{
+    // Wait runs the group's own queued tasks instead of just blocking, so tasks may wait on their own subtasks
+    class TaskGroup
+    {
+        public:
+            TaskGroup();
+            ~TaskGroup();
+            void Run(std::function<void()> Task);
+            void Wait();
+            bool IsDone();
+        private:
+            std::atomic<u32> pending;
+    };
+
+    struct TaskNode
+    {
+        std::function<void()> Task;
+        std::vector<u32> Next;
+        u32 Dependencies;
+        std::atomic<u32> Remaining;
+    };
+
+    // Nodes are submitted as soon as everything they depend on has finished (the graph must be acyclic)
+    class TaskGraph
+    {
+        public:
+            TaskGraph();
+            ~TaskGraph();
+            u32 Add(std::function<void()> Task);
+            void Depend(u32 Task, u32 On);
+            void Run();
+        private:
+            void Submit(u32 Index, TaskGroup *Group);
+            std::vector<TaskNode*> nodes;
+    };
+
+    void StartTaskPool(u32 Workers = 0);
+    void StopTaskPool();
+    u32 GetTaskPoolWorkerCount();
+    u64 GetUsableCoreMask();
+    void SubmitTask(std::function<void()> Task);
+    bool RunPendingTask();
+    void ParallelFor(u64 Begin, u64 End, u64 Grain, std::function<void(u64 Begin, u64 End)> Body);
+    bool CheckTaskPool(std::string LogPath);
+}
\ No newline at end of file
@@ -12,10 +12,13 @@
 #include <switch.h>
 #include <string>
 #include <vector>
+#include <functional>
+#include <memory>
 #include <gleaf/Types.hpp>
 #include <gleaf/ncm.hpp>
 #include <gleaf/ns.hpp>
 #include <gleaf/es.hpp>
+#include <gleaf/Progress.hpp>
 
 namespace gleaf::horizon
 {
@@ -68,6 +71,23 @@ namespace gleaf::horizon
         std::string GetFormattedTotalSize();
     };
 
+    struct ControlCacheStamp
+    {
+        u32 Magic;
+        u32 Format;
+        u32 Version;
+        u32 IconSize;
+    };
+
+    static const u32 ControlCacheMagic = 0x43434C47;
+    static const u32 ControlCacheFormat = 1;
+
+    struct ControlData
+    {
+        NacpStruct NACP;
+        std::vector<u8> Icon;
+    };
+
     struct Title
     {
         u64 ApplicationId;
@@ -76,9 +96,13 @@ namespace gleaf::horizon
         NcmMetaRecord Record;
         Storage Location;
         
+        std::shared_ptr<ControlData> GetControlData();
         NacpStruct *TryGetNACP();
         u8 *TryGetIcon();
         bool DumpControlData();
+        bool IsControlDataCached();
+        bool HasCachedIcon();
+        NacpStruct *TryGetCachedNACP(bool *HasIcon = NULL);
         TitleContents GetContents();
         bool IsBaseTitle();
         bool IsUpdate();
@@ -109,8 +133,13 @@ namespace gleaf::horizon
     bool ExistsTitle(ncm::ContentMetaType Type, Storage Location, u64 ApplicationId);
     std::vector<Ticket> GetAllTickets();
     Result RemoveTitle(Title &ToRemove);
+    Result MoveTitle(Title &ToMove, Storage Destination, Progress &Prog);
     std::string GetExportedIconPath(u64 ApplicationId);
     std::string GetExportedNACPPath(u64 ApplicationId);
+    std::string GetExportedControlStampPath(u64 ApplicationId);
+    void SetControlDataCacheBudget(u64 Bytes);
+    u64 GetControlDataCacheSize();
+    void ClearControlDataCache();
     u64 GetBaseApplicationId(u64 ApplicationId, ncm::ContentMetaType Type);
     ApplicationIdMask IsValidApplicationId(u64 ApplicationId);
     TicketData ReadTicket(std::string Path);
@@ -25,6 +25,7 @@ namespace gleaf::ncm
             ContentMetaHeader GetContentMetaHeader();
             NcmMetaRecord GetContentMetaKey();
             std::vector<ContentRecord> GetContentRecords();
+            std::vector<HashedContentRecord> GetHashedContentRecords();
             void GetInstallContentMeta(ByteBuffer &CNMTBuffer, ContentRecord &CNMTRecord, bool IgnoreVersion);
         private:
             ByteBuffer buf;
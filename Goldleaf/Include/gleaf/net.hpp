@@ -11,4 +11,7 @@
 */
 
 #pragma once
-#include <gleaf/net/Network.hpp>
\ No newline at end of file
+#include <gleaf/net/Download.hpp>
+#include <gleaf/net/Network.hpp>
+#include <gleaf/net/Session.hpp>
+#include <gleaf/net/Update.hpp>
\ No newline at end of file
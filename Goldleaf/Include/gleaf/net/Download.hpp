@@ -0,0 +1,33 @@
+
+/*
+
+    Goldleaf - Nintendo Switch homebrew multitool, for several purposes and with several features
+
+    Copyright 2018 - 2019 Goldleaf project, developed by XorTroll
+    This project is under the terms of GPLv3 license: https://github.com/XorTroll/Goldleaf/blob/master/LICENSE
+
+*/
+
+#pragma once
+#include <atomic>
+#include <gleaf/Types.hpp>
+#include <gleaf/Progress.hpp>
+#include <gleaf/err/Error.hpp>
+#include <curl/curl.h>
+
+namespace gleaf::net
+{
+    struct DownloadSegment
+    {
+        u64 Offset;
+        u64 Size;
+        u64 Done;
+    };
+
+    // Ranged segments are fetched in parallel into the preallocated file; their state is kept in a sidecar file so a failed download resumes, as long as the server's ETag or Last-Modified still matches
+    Result DownloadFile(std::string URL, std::string Path, Progress &Prog, u32 Segments = 4);
+    std::string GetDownloadStatePath(std::string Path);
+    // Reads a byte range into memory, split over several connections; returns how many bytes from Offset on arrived (fewer once Cancel is set)
+    u64 RetrieveRange(std::string URL, u64 Offset, u64 Size, u8 *Out, u32 Connections = 1, std::atomic<bool> *Cancel = NULL);
+    bool RetrieveFileSize(std::string URL, u64 &Size, bool &Ranges);
+}
\ No newline at end of file
@@ -10,12 +10,14 @@
 
 #pragma once
 #include <gleaf/Types.hpp>
+#include <gleaf/Progress.hpp>
+#include <gleaf/net/Download.hpp>
 #include <curl/curl.h>
 
 namespace gleaf::net
 {
     std::string RetrieveContent(std::string URL, std::string MIMEType = "");
-    void RetrieveToFile(std::string URL, std::string Path, std::function<void(double Done, double Total)> Callback);
+    Result RetrieveToFile(std::string URL, std::string Path, Progress &Prog);
     bool CheckVersionDiff();
     bool HasConnection();
 }
\ No newline at end of file
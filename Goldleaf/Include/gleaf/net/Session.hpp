@@ -0,0 +1,23 @@
+
+/*
+
+    Goldleaf - Nintendo Switch homebrew multitool, for several purposes and with several features
+
+    Copyright 2018 - 2019 Goldleaf project, developed by XorTroll
+    This project is under the terms of GPLv3 license: https://github.com/XorTroll/Goldleaf/blob/master/LICENSE
+
+*/
+
+#pragma once
+#include <gleaf/Types.hpp>
+#include <curl/curl.h>
+
+namespace gleaf::net
+{
+    // Sockets stay up and DNS, TLS sessions and open connections are shared between requests, so back-to-back requests skip the setup
+    void OpenSession();
+    void CloseSession();
+    bool IsSessionOpen();
+    CURL *AcquireHandle(std::string URL);
+    void ReleaseHandle(CURL *Handle);
+}
\ No newline at end of file
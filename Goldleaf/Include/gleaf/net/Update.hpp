@@ -0,0 +1,42 @@
+
+/*
+
+    Goldleaf - Nintendo Switch homebrew multitool, for several purposes and with several features
+
+    Copyright 2018 - 2019 Goldleaf project, developed by XorTroll
+    This project is under the terms of GPLv3 license: https://github.com/XorTroll/Goldleaf/blob/master/LICENSE
+
+*/
+
+#pragma once
+#include <gleaf/Types.hpp>
+
+namespace gleaf::net
+{
+    enum class UpdateCheckState
+    {
+        Idle,
+        Running,
+        Finished,
+    };
+
+    struct UpdateCheckResult
+    {
+        bool Ok;
+        bool HasUpdate;
+        std::string LatestVersion;
+    };
+
+    static const u64 ReleasesCacheTTL = 21600;
+
+    // The endpoint can be pointed to any server serving the same JSON (e.g. a local one for testing)
+    void SetReleasesEndpoint(std::string URL);
+    std::string GetReleasesEndpoint();
+    std::string FetchReleases(bool ForceRefresh = false);
+    bool ParseLatestRelease(std::string JSON, std::string &LatestId);
+    void StartUpdateCheck();
+    UpdateCheckState GetUpdateCheckState();
+    bool ConsumeUpdateCheckResult(UpdateCheckResult &Out);
+    // Aborts a running check's transfer and joins its thread; called before the network session is closed
+    void StopUpdateCheck();
+}
\ No newline at end of file
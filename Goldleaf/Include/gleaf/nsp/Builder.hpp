@@ -13,6 +13,7 @@
 #pragma once
 #include <string>
 #include <gleaf/Types.hpp>
+#include <gleaf/Progress.hpp>
 
 namespace gleaf::nsp
 {
@@ -32,5 +33,5 @@ namespace gleaf::nsp
         u32 Zero;
     };
 
-    int BuildPFS(std::string ContentsDir, std::string OutPFS, std::function<void(u8 Percentage)> Callback);
+    int BuildPFS(std::string ContentsDir, std::string OutPFS, Progress &Prog);
 }
\ No newline at end of file
@@ -28,7 +28,6 @@ namespace gleaf::nsp
             Installer(std::string Path, fs::Explorer *Exp, Storage Location);
             ~Installer();
             Result PrepareInstallation();
-            Result PreProcessContents();
             ncm::ContentMetaType GetContentMetaType();
             u64 GetApplicationId();
             std::string GetExportedIconPath();
@@ -36,9 +35,10 @@ namespace gleaf::nsp
             bool HasTicket();
             horizon::TicketData GetTicketData();
             std::vector<ncm::ContentRecord> GetNCAs();
-            Result WriteContents(std::function<void(ncm::ContentRecord Record, u32 Content, u32 ContentCount, double Done, double Total, u64 BytesSec)> OnContentWrite);
+            Result WriteContents(std::function<void(ncm::ContentRecord Record, u32 Content, u32 ContentCount)> OnContentStart, Progress &Prog);
             void FinalizeInstallation();
         private:
+            Result RegisterContents();
             PFS0 nspentry;
             NacpStruct *entrynacp;
             horizon::TicketData entrytik;
@@ -51,7 +51,7 @@ namespace gleaf::nsp
             bool IsOk();
             fs::Explorer *GetExplorer();
             u64 GetFileSize(u32 Index);
-            void SaveFile(u32 Index, fs::Explorer *Exp, std::string Path);
+            bool SaveFile(u32 Index, fs::Explorer *Exp, std::string Path);
             u32 GetFileIndexByName(std::string File);
         private:
             std::string path;
@@ -23,6 +23,8 @@ namespace gleaf::set
         ColorScheme CustomScheme;
         u32 MenuItemSize;
         bool IgnoreRequiredFirmwareVersion;
+        std::string ReleasesEndpoint;
+        bool TaskPoolSelfCheck;
 
         std::string PathForResource(std::string Path);
     };
@@ -9,20 +9,24 @@
 */
 
 #pragma once
+#include <string_view>
 #include <gleaf/set/Settings.hpp>
 
 namespace gleaf::set
 {
+    // Loaded from the binary tables made by BuildTools/StringTable.py (JSON is only a fallback for RomFs replacements)
     struct Dictionary
     {
         Language DictLanguage;
-        json Strings;
+        std::vector<u8> Data;
+        u32 Count;
+        const u32 *Offsets;
+        const char *Strings;
     };
 
-    static Dictionary MainDictionary;
-    static Dictionary Errors;
-    
     void Initialize();
+    std::string_view GetDictionaryView(u32 Index);
+    std::string_view GetErrorView(u32 Index);
     std::string GetDictionaryEntry(u32 Index);
     std::string GetErrorEntry(u32 Index);
-}
+}
\ No newline at end of file
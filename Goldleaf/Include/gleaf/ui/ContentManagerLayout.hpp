@@ -24,12 +24,14 @@ namespace gleaf::ui
             void nandSystemMenuItem_Click();
             void gameCartMenuItem_Click();
             void unusedTicketsMenuItem_Click();
+            void verifyMenuItem_Click();
         private:
             pu::element::MenuItem *sdCardMenuItem;
             pu::element::MenuItem *nandUserMenuItem;
             pu::element::MenuItem *nandSystemMenuItem;
             pu::element::MenuItem *gameCartMenuItem;
             pu::element::MenuItem *unusedTicketsMenuItem;
+            pu::element::MenuItem *verifyMenuItem;
             pu::element::Menu *typesMenu;
     };
 }
\ No newline at end of file
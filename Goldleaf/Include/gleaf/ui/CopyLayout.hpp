@@ -11,6 +11,7 @@
 #pragma once
 #include <gleaf/Goldleaf>
 #include <pu/Plutonium>
+#include <gleaf/ui/GlyphAtlas.hpp>
 
 namespace gleaf::ui
 {
@@ -22,7 +23,7 @@ namespace gleaf::ui
             void StartCopy(std::string Path, std::string NewPath, bool Directory, fs::Explorer *Exp, pu::Layout *Prev);
         private:
             fs::Explorer *gexp;
-            pu::element::TextBlock *infoText;
+            AtlasText *infoText;
             pu::element::ProgressBar *copyBar;
     };
 }
\ No newline at end of file
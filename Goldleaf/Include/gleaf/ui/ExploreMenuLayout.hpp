@@ -23,6 +23,7 @@ namespace gleaf::ui
             void sdCard_Click();
             void pcDrive_Click();
             void usbDrive_Click();
+            void httpServer_Click();
             void nandProdInfoF_Click();
             void nandSafe_Click();
             void nandUser_Click();
@@ -35,11 +36,13 @@ namespace gleaf::ui
             pu::element::MenuItem *sdCardMenuItem;
             pu::element::MenuItem *pcDriveMenuItem;
             pu::element::MenuItem *usbDriveMenuItem;
+            pu::element::MenuItem *httpServerMenuItem;
             pu::element::MenuItem *nandProfInfoFMenuItem;
             pu::element::MenuItem *nandSafeMenuItem;
             pu::element::MenuItem *nandUserMenuItem;
             pu::element::MenuItem *nandSystemMenuItem;
             std::vector<pu::element::MenuItem*> mounts;
             std::vector<fs::Explorer*> expls;
+            std::string httpurl;
     };
 }
\ No newline at end of file
@@ -11,6 +11,7 @@
 #pragma once
 #include <gleaf/Goldleaf>
 #include <pu/Plutonium>
+#include <gleaf/ui/GlyphAtlas.hpp>
 
 namespace gleaf::ui
 {
@@ -29,7 +30,7 @@ namespace gleaf::ui
             u32 rlines;
             bool mode;
             std::string pth;
-            pu::element::TextBlock *cntText;
+            AtlasText *cntText;
             fs::Explorer *gexp;
             pu::Layout *prev;
     };
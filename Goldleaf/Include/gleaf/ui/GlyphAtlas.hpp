@@ -0,0 +1,83 @@
+
+/*
+
+    Goldleaf - Nintendo Switch homebrew multitool, for several purposes and with several features
+
+    Copyright 2018 - 2019 Goldleaf project, developed by XorTroll
+    This project is under the terms of GPLv3 license: https://github.com/XorTroll/Goldleaf/blob/master/LICENSE
+
+*/
+
+#pragma once
+#include <pu/Plutonium>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace gleaf::ui
+{
+    struct AtlasGlyph
+    {
+        bool Valid;
+        u32 Page;
+        SDL_Rect Source;
+        int MinX;
+        int MaxY;
+        int Advance;
+    };
+
+    // Glyphs of one font are rasterised once into shared pages and strings are drawn as quads from them
+    class GlyphAtlas
+    {
+        public:
+            GlyphAtlas(pu::render::NativeFont Font);
+            ~GlyphAtlas();
+            u32 GetTextWidth(std::string Text);
+            u32 GetTextHeight(std::string Text);
+            void RenderText(std::string Text, u32 X, u32 Y, pu::draw::Color Color);
+            void Clear();
+        private:
+            AtlasGlyph *FindGlyph(u16 Code);
+            bool PlaceGlyph(u32 Width, u32 Height, u32 &Page, SDL_Rect &Out);
+            pu::render::NativeFont fnt;
+            std::unordered_map<u16, AtlasGlyph> glyphs;
+            std::vector<pu::render::NativeTexture> pages;
+            u32 curx;
+            u32 cury;
+            u32 rowh;
+    };
+
+    GlyphAtlas *GetGlyphAtlas(pu::render::NativeFont Font);
+    GlyphAtlas *GetSharedGlyphAtlas(u32 Size);
+    void ClearGlyphAtlases();
+
+    // Drop-in for pu's TextBlock: text changes only re-layout, nothing is rasterised per string
+    class AtlasText : public pu::element::Element
+    {
+        public:
+            AtlasText(u32 X, u32 Y, std::string Text, u32 FontSize = 25);
+            u32 GetX();
+            void SetX(u32 X);
+            u32 GetY();
+            void SetY(u32 Y);
+            u32 GetWidth();
+            u32 GetHeight();
+            u32 GetTextWidth();
+            u32 GetTextHeight();
+            std::string GetText();
+            void SetText(std::string Text);
+            void SetFont(pu::render::NativeFont Font);
+            pu::draw::Color GetColor();
+            void SetColor(pu::draw::Color Color);
+            void OnRender(pu::render::Renderer *Drawer);
+            void OnInput(u64 Down, u64 Up, u64 Held, bool Touch, bool Focus);
+        private:
+            std::string text;
+            u32 x;
+            u32 y;
+            GlyphAtlas *atlas;
+            pu::draw::Color clr;
+            u32 tw;
+            u32 th;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+
+/*
+
+    Goldleaf - Nintendo Switch homebrew multitool, for several purposes and with several features
+
+    Copyright 2018 - 2019 Goldleaf project, developed by XorTroll
+    This project is under the terms of GPLv3 license: https://github.com/XorTroll/Goldleaf/blob/master/LICENSE
+
+*/
+
+#pragma once
+#include <pu/Plutonium>
+#include <string>
+
+namespace gleaf::ui
+{
+    struct AtlasIcon
+    {
+        pu::render::NativeTexture Texture;
+        SDL_Rect Source;
+    };
+
+    // Small RomFs icons, packed at build time by BuildTools/TextureAtlas.py into one texture
+    bool LoadIconAtlas();
+    void UnloadIconAtlas();
+    // Only stock RomFs paths are found, so icons replaced through romFsReplace still load from their own files
+    bool FindAtlasIcon(std::string Path, AtlasIcon &Out);
+    void RenderAtlasIcon(AtlasIcon &Icon, u32 X, u32 Y, u32 Width, u32 Height);
+}
\ No newline at end of file
@@ -11,6 +11,7 @@
 #pragma once
 #include <gleaf/Goldleaf>
 #include <pu/Plutonium>
+#include <gleaf/ui/GlyphAtlas.hpp>
 
 namespace gleaf::ui
 {
@@ -21,7 +22,7 @@ namespace gleaf::ui
             ~InstallLayout();
             void StartInstall(std::string Path, fs::Explorer *Exp, Storage Location, pu::Layout *Prev);
         private:
-            pu::element::TextBlock *installText;
+            AtlasText *installText;
             pu::element::ProgressBar *installBar;
     };
 }
\ No newline at end of file
@@ -16,19 +16,32 @@
 #include <gleaf/ui/CopyLayout.hpp>
 #include <gleaf/ui/ExploreMenuLayout.hpp>
 #include <gleaf/ui/FileContentLayout.hpp>
+#include <gleaf/ui/GlyphAtlas.hpp>
 #include <gleaf/ui/InstallLayout.hpp>
 #include <gleaf/ui/MainMenuLayout.hpp>
 #include <gleaf/ui/PartitionBrowserLayout.hpp>
 #include <gleaf/ui/PCExploreLayout.hpp>
+#include <gleaf/ui/StatusService.hpp>
 #include <gleaf/ui/StorageContentsLayout.hpp>
 #include <gleaf/ui/SystemInfoLayout.hpp>
+#include <gleaf/ui/TextureCache.hpp>
 #include <gleaf/ui/TicketManagerLayout.hpp>
 #include <gleaf/ui/TitleDumperLayout.hpp>
 #include <gleaf/ui/UpdateLayout.hpp>
 #include <gleaf/ui/USBDrivesLayout.hpp>
+#include <gleaf/ui/VerifyLayout.hpp>
 
 namespace gleaf::ui
 {
+    struct WatchedJob
+    {
+        std::shared_ptr<Job> Target;
+        AtlasText *Text;
+        pu::element::ProgressBar *Bar;
+        std::function<void(Job &Done)> OnDone;
+        std::string Last;
+    };
+
     class MainApplication : public pu::Application
     {
         public:
@@ -36,6 +49,8 @@ namespace gleaf::ui
             ~MainApplication();
             void ShowNotification(std::string Text);
             void UpdateValues();
+            void WatchJob(std::shared_ptr<Job> Target, AtlasText *Text, pu::element::ProgressBar *Bar, std::function<void(Job &Done)> OnDone);
+            void UpdateJob();
             void LoadMenuData(std::string Name, std::string ImageName, std::string TempHead, bool CommonIcon = true);
             void LoadMenuHead(std::string Head);
             void UnloadMenuData();
@@ -69,12 +84,15 @@ namespace gleaf::ui
             SystemInfoLayout *GetSystemInfoLayout();
             UpdateLayout *GetUpdateLayout();
             AboutLayout *GetAboutLayout();
+            VerifyLayout *GetVerifyLayout();
         private:
+            void AddBaseElements(pu::Layout *Target, bool Banner = false);
             StartMode stmode;
             u32 preblv;
             bool preisch;
             bool hasusb;
             u32 connstate;
+            u32 preip;
             std::string pretime;
             bool vfirst;
             MainMenuLayout *mainMenu;
@@ -94,20 +112,23 @@ namespace gleaf::ui
             SystemInfoLayout *sysInfo;
             UpdateLayout* update;
             AboutLayout *about;
+            VerifyLayout *verify;
             pu::element::Image *baseImage;
-            pu::element::TextBlock *timeText;
-            pu::element::TextBlock *batteryText;
-            pu::element::Image *batteryImage;
-            pu::element::Image *batteryChargeImage;
+            AtlasText *timeText;
+            AtlasText *batteryText;
+            CachedImage *batteryImage;
+            CachedImage *batteryChargeImage;
             pu::element::Image *menuBanner;
-            pu::element::Image *menuImage;
-            pu::element::Image *usbImage;
-            pu::element::Image *connImage;
-            pu::element::TextBlock *ipText;
-            pu::element::TextBlock *menuNameText;
-            pu::element::TextBlock *menuHeadText;
+            CachedImage *menuImage;
+            CachedImage *usbImage;
+            CachedImage *connImage;
+            AtlasText *ipText;
+            AtlasText *menuNameText;
+            AtlasText *menuHeadText;
             pu::overlay::Toast *toast;
+            std::vector<WatchedJob> watched;
             bool updshown;
+            bool traced;
             std::chrono::time_point<std::chrono::steady_clock> start;
     };
 
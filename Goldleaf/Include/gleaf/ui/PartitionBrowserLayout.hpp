@@ -11,6 +11,7 @@
 #pragma once
 #include <gleaf/Goldleaf>
 #include <pu/Plutonium>
+#include <gleaf/ui/VirtualMenu.hpp>
 
 namespace gleaf::ui
 {
@@ -22,7 +23,11 @@ namespace gleaf::ui
             void ChangePartitionSdCard(bool Update = true);
             void ChangePartitionNAND(fs::Partition Partition, bool Update = true);
             void ChangePartitionPCDrive(std::string Mount, bool Update = true);
+            void ChangePartitionHTTP(std::string URL, bool Update = true);
+            void ChangePartitionExplorer(fs::Explorer *Exp, bool Update = true);
             void UpdateElements();
+            pu::element::MenuItem *CreateItem(u32 Index);
+            std::string GetItemIcon(u32 Index);
             bool GoBack();
             bool WarnNANDWriteAccess();
             void fsItems_Click();
@@ -31,7 +36,7 @@ namespace gleaf::ui
         private:
             fs::Explorer *gexp;
             std::vector<std::string> elems;
-            pu::element::Menu *browseMenu;
+            VirtualMenu *browseMenu;
             pu::element::TextBlock *dirEmptyText;
     };
 }
\ No newline at end of file
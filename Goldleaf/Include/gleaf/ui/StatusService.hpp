@@ -0,0 +1,30 @@
+
+/*
+
+    Goldleaf - Nintendo Switch homebrew multitool, for several purposes and with several features
+
+    Copyright 2018 - 2019 Goldleaf project, developed by XorTroll
+    This project is under the terms of GPLv3 license: https://github.com/XorTroll/Goldleaf/blob/master/LICENSE
+
+*/
+
+#pragma once
+#include <gleaf/Types.hpp>
+
+namespace gleaf::ui
+{
+    struct StatusSnapshot
+    {
+        std::string Time;
+        u32 BatteryLevel;
+        bool Charging;
+        bool USBPlugged;
+        u32 ConnectionStrength;
+        u32 IPAddress;
+    };
+
+    // Every source is polled at its own rate on a background thread; the UI only picks up changes
+    void StartStatusService();
+    void StopStatusService();
+    bool ConsumeStatusChanges(StatusSnapshot &Out);
+}
\ No newline at end of file
@@ -11,6 +11,7 @@
 #pragma once
 #include <gleaf/Goldleaf>
 #include <pu/Plutonium>
+#include <gleaf/ui/VirtualMenu.hpp>
 
 namespace gleaf::ui
 {
@@ -22,9 +23,21 @@ namespace gleaf::ui
             void contents_Click();
             void LoadFromStorage(Storage Location);
             std::vector<horizon::Title> GetContents();
+            void UpdateControlData();
+            pu::element::MenuItem *CreateItem(u32 Index);
+            std::string GetItemIcon(u32 Index);
         private:
+            static void FetchControlData(void *Args);
+            void StopFetch();
             std::vector<horizon::Title> contents;
+            std::vector<std::string> names;
+            std::vector<bool> icons;
+            std::vector<u32> pending;
+            std::vector<u32> fetched;
+            horizon::Thread *fetcher;
+            bool fetchcancel;
+            Mutex fetchlock;
             pu::element::TextBlock *noContentsText;
-            pu::element::Menu *contentsMenu;
+            VirtualMenu *contentsMenu;
     };
 }
\ No newline at end of file
@@ -0,0 +1,60 @@
+
+/*
+
+    Goldleaf - Nintendo Switch homebrew multitool, for several purposes and with several features
+
+    Copyright 2018 - 2019 Goldleaf project, developed by XorTroll
+    This project is under the terms of GPLv3 license: https://github.com/XorTroll/Goldleaf/blob/master/LICENSE
+
+*/
+
+#pragma once
+#include <pu/Plutonium>
+#include <gleaf/ui/IconAtlas.hpp>
+#include <string>
+
+namespace gleaf::ui
+{
+    // Textures are shared by path and size: a width/height of 0 keeps the image's own size
+    pu::render::NativeTexture AcquireTexture(std::string Path, u32 Width = 0, u32 Height = 0);
+    // Decodes on a worker thread and returns NULL until ready; the texture itself is always created on the calling (render) thread
+    pu::render::NativeTexture AcquireTextureAsync(std::string Path, u32 Width = 0, u32 Height = 0);
+    void CancelTextureDecodes();
+    // Drops a pending or failed decode, so the next request decodes the file again
+    void ForgetTextureDecode(std::string Path, u32 Width = 0, u32 Height = 0);
+    // For files rewritten in place (exported title icons): textures loaded from an older version of the file are dropped
+    void InvalidateTexture(std::string Path);
+    void ReleaseTexture(pu::render::NativeTexture Texture);
+    void SetTextureCacheBudget(u64 Bytes);
+    u64 GetTextureCacheSize();
+    void ClearTextureCache();
+
+    class CachedImage : public pu::element::Element
+    {
+        public:
+            CachedImage(u32 X, u32 Y, std::string Image);
+            ~CachedImage();
+            u32 GetX();
+            void SetX(u32 X);
+            u32 GetY();
+            void SetY(u32 Y);
+            u32 GetWidth();
+            void SetWidth(u32 Width);
+            u32 GetHeight();
+            void SetHeight(u32 Height);
+            std::string GetImage();
+            void SetImage(std::string Image);
+            bool IsImageValid();
+            void OnRender(pu::render::Renderer *Drawer);
+            void OnInput(u64 Down, u64 Up, u64 Held, bool Touch, bool Focus);
+        private:
+            std::string img;
+            pu::render::NativeTexture ntex;
+            AtlasIcon aicon;
+            bool inatlas;
+            u32 x;
+            u32 y;
+            u32 w;
+            u32 h;
+    };
+}
@@ -11,6 +11,7 @@
 #pragma once
 #include <gleaf/Goldleaf>
 #include <pu/Plutonium>
+#include <gleaf/ui/GlyphAtlas.hpp>
 
 namespace gleaf::ui
 {
@@ -20,8 +21,9 @@ namespace gleaf::ui
             TitleDumperLayout();
             ~TitleDumperLayout();
             void StartDump(horizon::Title &Target);
+            void StartMove(horizon::Title &Target, Storage Destination);
         private:
-            pu::element::TextBlock *dumpText;
+            AtlasText *dumpText;
             pu::element::ProgressBar *ncaBar;
     };
 }
\ No newline at end of file
@@ -11,6 +11,7 @@
 #pragma once
 #include <gleaf/Goldleaf>
 #include <pu/Plutonium>
+#include <gleaf/ui/GlyphAtlas.hpp>
 
 namespace gleaf::ui
 {
@@ -20,8 +21,11 @@ namespace gleaf::ui
             UpdateLayout();
             ~UpdateLayout();
             void StartUpdateSearch();
+            void OnNRODownloaded(std::string BaseURL, Job &Done);
+            void OnNSPDownloaded(std::string NSP, Job &Done);
+            void FinishUpdate();
         private:
-            pu::element::TextBlock *infoText;
+            AtlasText *infoText;
             pu::element::ProgressBar *downloadBar;
     };
 }
\ No newline at end of file
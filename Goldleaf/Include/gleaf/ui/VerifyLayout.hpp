@@ -0,0 +1,28 @@
+
+/*
+
+    Goldleaf - Nintendo Switch homebrew multitool, for several purposes and with several features
+
+    Copyright 2018 - 2019 Goldleaf project, developed by XorTroll
+    This project is under the terms of GPLv3 license: https://github.com/XorTroll/Goldleaf/blob/master/LICENSE
+
+*/
+
+#pragma once
+#include <gleaf/Goldleaf>
+#include <pu/Plutonium>
+#include <gleaf/ui/GlyphAtlas.hpp>
+
+namespace gleaf::ui
+{
+    class VerifyLayout : public pu::Layout
+    {
+        public:
+            VerifyLayout();
+            ~VerifyLayout();
+            void StartVerify(pu::Layout *Prev);
+        private:
+            AtlasText *infoText;
+            pu::element::ProgressBar *verifyBar;
+    };
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+
+/*
+
+    Goldleaf - Nintendo Switch homebrew multitool, for several purposes and with several features
+
+    Copyright 2018 - 2019 Goldleaf project, developed by XorTroll
+    This project is under the terms of GPLv3 license: https://github.com/XorTroll/Goldleaf/blob/master/LICENSE
+
+*/
+
+#pragma once
+#include <pu/Plutonium>
+#include <gleaf/ui/TextureCache.hpp>
+#include <functional>
+#include <chrono>
+#include <map>
+
+namespace gleaf::ui
+{
+    // Menu items are only created for the rows on screen, everything else is asked to the data source on demand
+    struct MenuDataSource
+    {
+        std::function<u32()> GetCount;
+        std::function<pu::element::MenuItem*(u32 Index)> GetItem;
+        std::function<std::string(u32 Index)> GetIcon;
+    };
+
+    class VirtualMenu : public pu::element::Element
+    {
+        public:
+            VirtualMenu(u32 X, u32 Y, u32 Width, pu::draw::Color OptionColor, u32 ItemSize, u32 ItemsToShow);
+            ~VirtualMenu();
+            u32 GetX();
+            u32 GetY();
+            u32 GetWidth();
+            u32 GetHeight();
+            void SetOnFocusColor(pu::draw::Color Color);
+            void SetScrollbarColor(pu::draw::Color Color);
+            void SetPlaceholderIcon(std::string Icon);
+            void SetOnSelectionChanged(std::function<void()> Callback);
+            void SetDataSource(MenuDataSource Source);
+            void ReloadItems();
+            void InvalidateItem(u32 Index);
+            u32 GetCount();
+            pu::element::MenuItem *GetSelectedItem();
+            u32 GetSelectedIndex();
+            void SetSelectedIndex(u32 Index);
+            void OnRender(pu::render::Renderer *Drawer);
+            void OnInput(u64 Down, u64 Up, u64 Held, bool Touch, bool Focus);
+        private:
+            pu::element::MenuItem *Materialize(u32 Index);
+            void Recycle(u32 Index);
+            void RecycleOutside();
+            void MoveSelection(s32 Offset);
+            u32 x;
+            u32 y;
+            u32 w;
+            u32 isize;
+            u32 ishow;
+            u32 fisel;
+            u32 isel;
+            pu::draw::Color clr;
+            pu::draw::Color fcs;
+            pu::draw::Color scb;
+            MenuDataSource src;
+            std::map<u32, pu::element::MenuItem*> rows;
+            std::map<u32, pu::render::NativeTexture> icons;
+            std::map<u32, AtlasIcon> aicons;
+            std::map<u32, std::string> waiting;
+            pu::render::NativeTexture phicon;
+            std::function<void()> onselch;
+            u64 hkey;
+            std::chrono::time_point<std::chrono::steady_clock> htp;
+            bool hrepeat;
+    };
+}
\ No newline at end of file
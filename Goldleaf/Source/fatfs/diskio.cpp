@@ -0,0 +1,94 @@
+#include <fatfs/fatfs.hpp>
+#include <fatfs/diskio.h>
+#include <gleaf/fs/Disk.hpp>
+#include <ctime>
+
+// FatFs' disk layer: every physical drive goes through the block cache of whatever device gleaf::fs::MountDisk attached to it
+
+extern "C"
+{
+    DSTATUS disk_initialize(BYTE pdrv)
+    {
+        return disk_status(pdrv);
+    }
+
+    DSTATUS disk_status(BYTE pdrv)
+    {
+        gleaf::fs::BlockCache *cache = gleaf::fs::GetDiskCache(pdrv);
+        if(cache == NULL) return STA_NOINIT;
+        return (cache->GetDevice()->IsReadOnly() ? STA_PROTECT : 0);
+    }
+
+    DRESULT disk_read(BYTE pdrv, BYTE *buff, DWORD sector, UINT count)
+    {
+        gleaf::fs::BlockCache *cache = gleaf::fs::GetDiskCache(pdrv);
+        if(cache == NULL) return RES_NOTRDY;
+        return (cache->Read(sector, count, buff) ? RES_OK : RES_ERROR);
+    }
+
+    DRESULT disk_write(BYTE pdrv, const BYTE *buff, DWORD sector, UINT count)
+    {
+        gleaf::fs::BlockCache *cache = gleaf::fs::GetDiskCache(pdrv);
+        if(cache == NULL) return RES_NOTRDY;
+        if(cache->GetDevice()->IsReadOnly()) return RES_WRPRT;
+        return (cache->Write(sector, count, buff) ? RES_OK : RES_ERROR);
+    }
+
+    DRESULT disk_ioctl(BYTE pdrv, BYTE cmd, void *buff)
+    {
+        gleaf::fs::BlockCache *cache = gleaf::fs::GetDiskCache(pdrv);
+        if(cache == NULL) return RES_NOTRDY;
+        switch(cmd)
+        {
+            case CTRL_SYNC:
+                return (cache->Flush() ? RES_OK : RES_ERROR);
+            case GET_SECTOR_COUNT:
+                *(DWORD*)buff = cache->GetDevice()->GetSectorCount();
+                return RES_OK;
+            case GET_SECTOR_SIZE:
+                *(WORD*)buff = cache->GetDevice()->GetSectorSize();
+                return RES_OK;
+            case GET_BLOCK_SIZE:
+                *(DWORD*)buff = 1;
+                return RES_OK;
+            default:
+                break;
+        }
+        return RES_PARERR;
+    }
+
+    // Volume locks for FF_FS_REENTRANT; waiting blocks instead of timing out
+    int ff_cre_syncobj(BYTE vol, FF_SYNC_t *sobj)
+    {
+        Mutex *mtx = new Mutex;
+        mutexInit(mtx);
+        *sobj = mtx;
+        return 1;
+    }
+
+    int ff_req_grant(FF_SYNC_t sobj)
+    {
+        mutexLock((Mutex*)sobj);
+        return 1;
+    }
+
+    void ff_rel_grant(FF_SYNC_t sobj)
+    {
+        mutexUnlock((Mutex*)sobj);
+    }
+
+    int ff_del_syncobj(FF_SYNC_t sobj)
+    {
+        delete (Mutex*)sobj;
+        return 1;
+    }
+
+    DWORD get_fattime()
+    {
+        time_t now = time(NULL);
+        struct tm *tm = localtime(&now);
+        // No usable clock: the same fixed date FatFs stamps with when built without an RTC
+        if((tm == NULL) || (tm->tm_year < 80)) return ((DWORD)(FF_NORTC_YEAR - 1980) << 25) | ((DWORD)FF_NORTC_MON << 21) | ((DWORD)FF_NORTC_MDAY << 16);
+        return ((DWORD)(tm->tm_year - 80) << 25) | ((DWORD)(tm->tm_mon + 1) << 21) | ((DWORD)tm->tm_mday << 16) | ((DWORD)tm->tm_hour << 11) | ((DWORD)tm->tm_min << 5) | ((DWORD)tm->tm_sec >> 1);
+    }
+}
\ No newline at end of file
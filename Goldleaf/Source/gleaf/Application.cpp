@@ -2,15 +2,18 @@
 #include <sys/stat.h>
 #include <cstdlib>
 #include <ctime>
+#include <fstream>
 
 extern char *fake_heap_end;
 
 namespace gleaf
 {
     static void *ghaddr;
+    static std::vector<std::pair<std::string, u64>> strace;
 
     void Initialize()
     {
+        TraceStartup("Initialize");
         srand(time(NULL));
         if(IsNRO() || IsQlaunch())
         {
@@ -34,10 +37,14 @@ namespace gleaf
         if(R_FAILED(bpcInitialize())) exit(1);
         if(R_FAILED(nifmInitialize())) exit(1);
         EnsureDirectories();
+        TraceStartup("Services initialized");
     }
 
     void Finalize()
     {
+        hactool::CloseDiagnostics();
+        net::StopUpdateCheck();
+        fs::CloseFatFsExplorers();
         fs::Explorer *nsys = fs::GetNANDSystemExplorer();
         fs::Explorer *nsfe = fs::GetNANDSafeExplorer();
         fs::Explorer *nusr = fs::GetNANDUserExplorer();
@@ -48,6 +55,7 @@ namespace gleaf
         delete nusr;
         delete prif;
         delete sdcd;
+        net::CloseSession();
         bpcExit();
         splExit();
         usbCommsExit();
@@ -67,9 +75,8 @@ namespace gleaf
 
     void EnsureDirectories()
     {
-        fs::Explorer *nsys = fs::GetNANDSystemExplorer();
-        nsys->DeleteDirectory("Contents/temp");
-        nsys->CreateDirectory("Contents/temp");
+        // NAND's Contents/temp is created and cleaned by the installer itself
+        if(fs::IsDirectory("sdmc:/goldleaf/dump/temp") && fs::IsDirectory("sdmc:/goldleaf/dump/out")) return;
         fs::CreateDirectory("sdmc:/goldleaf");
         fs::CreateDirectory("sdmc:/goldleaf/meta");
         fs::CreateDirectory("sdmc:/goldleaf/title");
@@ -79,6 +86,28 @@ namespace gleaf
         fs::CreateDirectory("sdmc:/goldleaf/dump/out");
     }
 
+    void TraceStartup(std::string Step)
+    {
+        if(strace.empty()) strace.reserve(16);
+        strace.push_back(std::make_pair(Step, armTicksToNs(armGetSystemTick())));
+    }
+
+    void SaveStartupTrace()
+    {
+        if(strace.empty()) return;
+        std::ofstream ofs("sdmc:/goldleaf/startup.log", std::ios::trunc);
+        u64 first = strace.front().second;
+        u64 prev = first;
+        for(u32 i = 0; i < strace.size(); i++)
+        {
+            u64 ns = strace[i].second;
+            ofs << ((ns - first) / 1000000) << " ms (+" << ((ns - prev) / 1000000) << " ms) " << strace[i].first << std::endl;
+            prev = ns;
+        }
+        ofs.close();
+        strace.clear();
+    }
+
     RunMode GetRunMode()
     {
         RunMode rmode = RunMode::Unknown;
@@ -0,0 +1,187 @@
+#include <gleaf/Job.hpp>
+#include <gleaf/horizon/Misc.hpp>
+#include <gleaf/err.hpp>
+#include <deque>
+
+namespace gleaf
+{
+    static std::deque<std::shared_ptr<Job>> jobqueue;
+    static std::shared_ptr<Job> jobcurrent;
+    static bool jobrunning = false;
+    static horizon::Thread *jobthread = NULL;
+    static Mutex joblock;
+    static CondVar jobcv;
+
+    Job::Job(std::string Name, std::function<Result(Job &Self)> Work)
+    {
+        this->name = Name;
+        this->work = Work;
+        this->state = JobState::Queued;
+        this->rc = 0;
+        mutexInit(&this->slock);
+    }
+
+    std::string Job::GetName()
+    {
+        return this->name;
+    }
+
+    JobState Job::GetState()
+    {
+        return this->state.load();
+    }
+
+    bool Job::IsDone()
+    {
+        JobState st = this->state.load();
+        return ((st == JobState::Finished) || (st == JobState::Cancelled));
+    }
+
+    Result Job::GetResult()
+    {
+        return this->rc.load();
+    }
+
+    Progress &Job::GetProgress()
+    {
+        return this->prog;
+    }
+
+    void Job::SetStatus(std::string Status)
+    {
+        mutexLock(&this->slock);
+        this->status = Status;
+        mutexUnlock(&this->slock);
+    }
+
+    std::string Job::GetStatus()
+    {
+        mutexLock(&this->slock);
+        std::string st = this->status;
+        mutexUnlock(&this->slock);
+        return st;
+    }
+
+    void Job::Cancel()
+    {
+        this->prog.Cancel();
+    }
+
+    void Job::Pause()
+    {
+        this->prog.Pause();
+    }
+
+    void Job::Resume()
+    {
+        this->prog.Resume();
+    }
+
+    bool Job::IsPaused()
+    {
+        return this->prog.IsPaused();
+    }
+
+    bool Job::IsCancelled()
+    {
+        return this->prog.IsCancelled();
+    }
+
+    void Job::Run()
+    {
+        if(this->prog.IsCancelled()) this->rc = err::Make(err::ErrorDescription::OperationCancelled);
+        else
+        {
+            this->state = JobState::Running;
+            this->rc = this->work(*this);
+        }
+        // Whatever the work captured (installers, open files...) is released here, on the worker
+        this->work = NULL;
+        this->prog.Flush();
+        this->state = ((this->prog.IsCancelled() && (this->rc.load() != 0)) ? JobState::Cancelled : JobState::Finished);
+    }
+
+    static void JobProcess(void *Args)
+    {
+        while(true)
+        {
+            mutexLock(&joblock);
+            // QueueJob and StopJobService signal it while holding joblock, so no wake-up is lost
+            while(jobrunning && jobqueue.empty()) condvarWait(&jobcv, &joblock);
+            if(!jobrunning)
+            {
+                mutexUnlock(&joblock);
+                break;
+            }
+            jobcurrent = jobqueue.front();
+            jobqueue.pop_front();
+            std::shared_ptr<Job> job = jobcurrent;
+            mutexUnlock(&joblock);
+            job->Run();
+            mutexLock(&joblock);
+            jobcurrent.reset();
+            mutexUnlock(&joblock);
+        }
+    }
+
+    void StartJobService()
+    {
+        mutexLock(&joblock);
+        if(jobrunning)
+        {
+            mutexUnlock(&joblock);
+            return;
+        }
+        condvarInit(&jobcv);
+        jobrunning = true;
+        mutexUnlock(&joblock);
+        jobthread = new horizon::Thread(&JobProcess, 0x40000);
+        if(jobthread->Start() != 0)
+        {
+            delete jobthread;
+            jobthread = NULL;
+            mutexLock(&joblock);
+            jobrunning = false;
+            mutexUnlock(&joblock);
+        }
+    }
+
+    void StopJobService()
+    {
+        if(jobthread == NULL) return;
+        mutexLock(&joblock);
+        jobrunning = false;
+        for(auto &job: jobqueue) job->Cancel();
+        jobqueue.clear();
+        if(jobcurrent) jobcurrent->Cancel();
+        condvarWakeAll(&jobcv);
+        mutexUnlock(&joblock);
+        jobthread->Join();
+        delete jobthread;
+        jobthread = NULL;
+    }
+
+    std::shared_ptr<Job> QueueJob(std::string Name, std::function<Result(Job &Self)> Work)
+    {
+        std::shared_ptr<Job> job = std::make_shared<Job>(Name, Work);
+        mutexLock(&joblock);
+        bool run = jobrunning;
+        if(run)
+        {
+            jobqueue.push_back(job);
+            condvarWakeOne(&jobcv);
+        }
+        mutexUnlock(&joblock);
+        // Without a worker (service failed to start) the job still runs, just inline
+        if(!run) job->Run();
+        return job;
+    }
+
+    u32 GetPendingJobCount()
+    {
+        mutexLock(&joblock);
+        u32 count = (jobqueue.size() + (jobcurrent ? 1 : 0));
+        mutexUnlock(&joblock);
+        return count;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include <gleaf/Progress.hpp>
+#include <algorithm>
+#include <cstdio>
+
+namespace gleaf
+{
+    static u64 GetMilliseconds()
+    {
+        return (armTicksToNs(armGetSystemTick()) / 1000000);
+    }
+
+    Progress::Progress()
+    {
+        this->interval = 16;
+        this->cb = NULL;
+        this->cancel = false;
+        this->pause = false;
+        mutexInit(&this->slock);
+        this->Reset();
+    }
+
+    void Progress::Reset()
+    {
+        this->done = 0;
+        this->total = 0;
+        this->idone = 0;
+        this->itotal = 0;
+        this->lastcb = 0;
+        mutexLock(&this->slock);
+        this->sdone = 0;
+        this->stime = GetMilliseconds();
+        this->rate = 0;
+        mutexUnlock(&this->slock);
+    }
+
+    void Progress::SetTotal(u64 Bytes, u32 Items)
+    {
+        this->total.store(Bytes, std::memory_order_relaxed);
+        this->itotal.store(Items, std::memory_order_relaxed);
+    }
+
+    void Progress::AddTotal(u64 Bytes, u32 Items)
+    {
+        this->total.fetch_add(Bytes, std::memory_order_relaxed);
+        this->itotal.fetch_add(Items, std::memory_order_relaxed);
+    }
+
+    void Progress::Advance(u64 Bytes)
+    {
+        this->done.fetch_add(Bytes, std::memory_order_relaxed);
+        this->Notify(false);
+    }
+
+    void Progress::SetDone(u64 Bytes)
+    {
+        this->done.store(Bytes, std::memory_order_relaxed);
+        this->Notify(false);
+    }
+
+    void Progress::CompleteItem()
+    {
+        u32 cur = (this->idone.fetch_add(1, std::memory_order_relaxed) + 1);
+        this->Notify(cur == this->GetItemsTotal());
+    }
+
+    u64 Progress::GetBytesDone()
+    {
+        return this->done.load(std::memory_order_relaxed);
+    }
+
+    u64 Progress::GetBytesTotal()
+    {
+        return this->total.load(std::memory_order_relaxed);
+    }
+
+    u32 Progress::GetItemsDone()
+    {
+        return this->idone.load(std::memory_order_relaxed);
+    }
+
+    u32 Progress::GetItemsTotal()
+    {
+        return this->itotal.load(std::memory_order_relaxed);
+    }
+
+    void Progress::SetOnSample(std::function<void(ProgressSample Sample)> Callback, u64 IntervalMs)
+    {
+        this->cb = Callback;
+        this->interval = IntervalMs;
+    }
+
+    ProgressSample Progress::Sample()
+    {
+        ProgressSample smp;
+        smp.BytesDone = this->GetBytesDone();
+        smp.BytesTotal = this->GetBytesTotal();
+        smp.ItemsDone = this->GetItemsDone();
+        smp.ItemsTotal = this->GetItemsTotal();
+        smp.Percentage = 0;
+        if(smp.BytesTotal > 0) smp.Percentage = (std::min(((double)smp.BytesDone / (double)smp.BytesTotal), 1.0) * 100.0);
+        else if(smp.ItemsTotal > 0) smp.Percentage = (std::min(((double)smp.ItemsDone / (double)smp.ItemsTotal), 1.0) * 100.0);
+        mutexLock(&this->slock);
+        u64 now = GetMilliseconds();
+        u64 dt = (now - this->stime);
+        if((dt >= 250) && (smp.BytesDone >= this->sdone))
+        {
+            double inst = (((double)(smp.BytesDone - this->sdone) * 1000.0) / (double)dt);
+            if(this->rate == 0) this->rate = inst;
+            else this->rate = ((this->rate * 0.7) + (inst * 0.3));
+            this->sdone = smp.BytesDone;
+            this->stime = now;
+        }
+        smp.Throughput = this->rate;
+        mutexUnlock(&this->slock);
+        smp.ETA = 0;
+        if((smp.Throughput > 0) && (smp.BytesTotal > smp.BytesDone)) smp.ETA = (u64)((double)(smp.BytesTotal - smp.BytesDone) / smp.Throughput);
+        return smp;
+    }
+
+    void Progress::Flush()
+    {
+        this->Notify(true);
+    }
+
+    void Progress::Cancel()
+    {
+        this->cancel.store(true);
+    }
+
+    bool Progress::IsCancelled()
+    {
+        return this->cancel.load();
+    }
+
+    void Progress::Pause()
+    {
+        this->pause.store(true);
+    }
+
+    void Progress::Resume()
+    {
+        this->pause.store(false);
+    }
+
+    bool Progress::IsPaused()
+    {
+        return this->pause.load();
+    }
+
+    bool Progress::CheckPoint()
+    {
+        while(this->pause.load() && !this->cancel.load()) svcSleepThread(10000000);
+        return !this->cancel.load();
+    }
+
+    void Progress::Notify(bool Force)
+    {
+        if(!this->cb) return;
+        u64 now = GetMilliseconds();
+        u64 prev = this->lastcb.load(std::memory_order_relaxed);
+        if(!Force && ((now - prev) < this->interval)) return;
+        if(!this->lastcb.compare_exchange_strong(prev, now) && !Force) return;
+        this->cb(this->Sample());
+    }
+
+    std::string FormatDuration(u64 Seconds)
+    {
+        char dur[32];
+        if(Seconds >= 3600) sprintf(dur, "%lu:%02lu:%02lu", (Seconds / 3600), ((Seconds / 60) % 60), (Seconds % 60));
+        else sprintf(dur, "%02lu:%02lu", (Seconds / 60), (Seconds % 60));
+        return std::string(dur);
+    }
+}
\ No newline at end of file
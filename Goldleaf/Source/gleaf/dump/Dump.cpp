@@ -3,6 +3,7 @@
 #include <gleaf/hactool.hpp>
 #include <gleaf/horizon.hpp>
 #include <fatfs/fatfs.hpp>
+#include <gleaf/fs/Disk.hpp>
 #include <gleaf/es.hpp>
 #include <sstream>
 #include <iomanip>
@@ -11,10 +12,11 @@ FsStorage fatfs_bin;
 
 namespace gleaf::dump
 {
-    void DecryptCopyNAX0ToNCA(NcmContentStorage *ncst, NcmNcaId NCAId, std::string Path, std::function<void(double Done, double Total)> Callback)
+    void DecryptCopyNAX0ToNCA(NcmContentStorage *ncst, NcmNcaId NCAId, std::string Path, Progress &Prog)
     {
         u64 ncasize = 0;
         ncmContentStorageGetSize(ncst, &NCAId, &ncasize);
+        if(Prog.GetBytesTotal() == 0) Prog.SetTotal(ncasize, 1);
         u64 szrem = ncasize;
         FILE *f = fopen(Path.c_str(), "wb");
         u64 off = 0;
@@ -22,14 +24,16 @@ namespace gleaf::dump
         u8 *data = fs::GetFileSystemOperationsBuffer();
         while(szrem)
         {
+            if(!Prog.CheckPoint()) break;
             u64 rsize = std::min(rmax, szrem);
             if(ncmContentStorageReadContentIdFile(ncst, &NCAId, off, data, rsize) != 0) break;
             fwrite(data, 1, rsize, f);
             szrem -= rsize;
             off += rsize;
-            Callback((double)off, (double)ncasize);
+            Prog.Advance(rsize);
         }
         fclose(f);
+        Prog.CompleteItem();
     }
 
     bool GetMetaRecord(NcmContentMetaDatabase *metadb, u64 ApplicationId, NcmMetaRecord *out)
@@ -78,9 +82,12 @@ namespace gleaf::dump
     std::string GetTitleKeyData(u64 ApplicationId, bool ExportData)
     {
         fsOpenBisStorage(&fatfs_bin, 31);
+        fs::StorageBlockDevice bisdev(&fatfs_bin);
+        fs::MountDisk(0, &bisdev);
         FATFS fs;
         FIL save;
         f_mount(&fs, "0", 1);
+        fs::PinFATRegion(0, &fs);
         f_chdir("/save");
         f_open(&save, "80000000000000e1", (FA_READ | FA_OPEN_EXISTING));
         std::string tkey = "";
@@ -143,6 +150,7 @@ namespace gleaf::dump
         }
         f_close(&save);
         f_mount(NULL, "0", 1);
+        fs::UnmountDisk(0);
         fsStorageClose(&fatfs_bin);
         if(ExportData && (tkey != ""))
         {
@@ -192,22 +200,18 @@ namespace gleaf::dump
 
     bool HasTitleKeyCrypto(std::string NCAPath)
     {
-        int outfd = dup(STDOUT_FILENO);
-        int errfd = dup(STDERR_FILENO);
-        freopen("sdmc:/goldleaf/dump/temp/hactool_stdout.log", "w", stdout);
-        freopen("sdmc:/goldleaf/dump/temp/hactool_stderr.log", "w", stderr);
-        hactool::ProcessResult pr = hactool::Process(NCAPath, hactool::Extraction::MakeExeFs("sdmc:/goldleaf/dump/temp/tfs"), hactool::ExtractionFormat::NCA, GetKeyFilePath());
-        fclose(stdout);
-        fclose(stderr);
-        dup2(outfd, STDOUT_FILENO);
-        dup2(errfd, STDERR_FILENO);
-        stdout = fdopen(STDOUT_FILENO, "w");
-        stderr = fdopen(STDERR_FILENO, "w");
-        close(outfd);
-        close(errfd);
-        if(!pr.Ok) return true;
-        bool ex = fs::IsDirectory("sdmc:/goldleaf/dump/temp/tfs");
-        if(ex) fs::DeleteDirectory("sdmc:/goldleaf/dump/temp/tfs");
-        return !ex;
+        fs::Explorer *exp = fs::GetExplorerForMountName(fs::GetPathRoot(NCAPath));
+        if(exp == NULL) return true;
+        nca_keyset_t *keys = (nca_keyset_t*)malloc(sizeof(nca_keyset_t));
+        if(keys == NULL) return true;
+        bool tkey = true;
+        if(hactool::GetKeyset(GetKeyFilePath(), keys))
+        {
+            // Only the header is decrypted: the rights id is there, no need to extract anything to find out
+            hactool::NCA nca(NCAPath, exp, keys);
+            if(nca.IsOk()) tkey = nca.HasRightsId();
+        }
+        free(keys);
+        return tkey;
     }
 }
\ No newline at end of file
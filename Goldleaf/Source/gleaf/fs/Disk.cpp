@@ -0,0 +1,433 @@
+#include <gleaf/fs/Disk.hpp>
+#include <algorithm>
+#include <cstring>
+
+namespace gleaf::fs
+{
+    static BlockCache *dcaches[FF_VOLUMES] = { NULL };
+
+    BlockDevice::~BlockDevice()
+    {
+    }
+
+    bool BlockDevice::Flush()
+    {
+        return true;
+    }
+
+    u32 BlockDevice::GetSectorSize()
+    {
+        return 512;
+    }
+
+    bool BlockDevice::IsReadOnly()
+    {
+        return false;
+    }
+
+    FileBlockDevice::FileBlockDevice(std::string Path, bool ReadOnly)
+    {
+        this->ro = ReadOnly;
+        this->sectors = 0;
+        this->f = fopen(Path.c_str(), (ReadOnly ? "rb" : "r+b"));
+        if(this->f)
+        {
+            fseeko(this->f, 0, SEEK_END);
+            this->sectors = (ftello(this->f) / this->GetSectorSize());
+        }
+    }
+
+    FileBlockDevice::~FileBlockDevice()
+    {
+        if(this->f) fclose(this->f);
+    }
+
+    bool FileBlockDevice::IsOk()
+    {
+        return ((this->f != NULL) && (this->sectors > 0));
+    }
+
+    bool FileBlockDevice::ReadSectors(u64 Sector, u32 Count, u8 *Out)
+    {
+        if(!this->f || ((Sector + Count) > this->sectors)) return false;
+        u64 size = ((u64)Count * this->GetSectorSize());
+        if(fseeko(this->f, (Sector * this->GetSectorSize()), SEEK_SET) != 0) return false;
+        return (fread(Out, 1, size, this->f) == size);
+    }
+
+    bool FileBlockDevice::WriteSectors(u64 Sector, u32 Count, const u8 *Data)
+    {
+        if(!this->f || this->ro || ((Sector + Count) > this->sectors)) return false;
+        u64 size = ((u64)Count * this->GetSectorSize());
+        if(fseeko(this->f, (Sector * this->GetSectorSize()), SEEK_SET) != 0) return false;
+        return (fwrite(Data, 1, size, this->f) == size);
+    }
+
+    bool FileBlockDevice::Flush()
+    {
+        if(!this->f) return false;
+        return (fflush(this->f) == 0);
+    }
+
+    u64 FileBlockDevice::GetSectorCount()
+    {
+        return this->sectors;
+    }
+
+    bool FileBlockDevice::IsReadOnly()
+    {
+        return this->ro;
+    }
+
+    StorageBlockDevice::StorageBlockDevice(FsStorage *Storage, bool ReadOnly)
+    {
+        this->stg = Storage;
+        this->ro = ReadOnly;
+        u64 size = 0;
+        fsStorageGetSize(this->stg, &size);
+        this->sectors = (size / this->GetSectorSize());
+    }
+
+    bool StorageBlockDevice::ReadSectors(u64 Sector, u32 Count, u8 *Out)
+    {
+        if((Sector + Count) > this->sectors) return false;
+        return (fsStorageRead(this->stg, (Sector * this->GetSectorSize()), Out, ((u64)Count * this->GetSectorSize())) == 0);
+    }
+
+    bool StorageBlockDevice::WriteSectors(u64 Sector, u32 Count, const u8 *Data)
+    {
+        if(this->ro || ((Sector + Count) > this->sectors)) return false;
+        return (fsStorageWrite(this->stg, (Sector * this->GetSectorSize()), Data, ((u64)Count * this->GetSectorSize())) == 0);
+    }
+
+    bool StorageBlockDevice::Flush()
+    {
+        if(this->ro) return true;
+        return (fsStorageFlush(this->stg) == 0);
+    }
+
+    u64 StorageBlockDevice::GetSectorCount()
+    {
+        return this->sectors;
+    }
+
+    bool StorageBlockDevice::IsReadOnly()
+    {
+        return this->ro;
+    }
+
+    BlockCache::BlockCache(BlockDevice *Device, u32 BlockSectors, u32 BlockCount, u32 ReadAhead)
+    {
+        this->dev = Device;
+        this->ssize = Device->GetSectorSize();
+        this->bsectors = std::max(BlockSectors, (u32)1);
+        this->rahead = std::max(ReadAhead, (u32)1);
+        this->tick = 0;
+        this->lastblock = (u64)-1;
+        this->pinstart = 0;
+        this->pinend = 0;
+        this->pinned = 0;
+        this->dreads = 0;
+        this->dwrites = 0;
+        u64 bsize = ((u64)this->bsectors * this->ssize);
+        u32 count = std::max(BlockCount, (this->rahead * 2));
+        this->pool.resize(count * bsize);
+        // Separate staging for write-backs: Load evicts (and may write back) while its read is still sitting in stage
+        this->stage.resize(this->rahead * bsize);
+        this->wstage.resize(this->rahead * bsize);
+        this->blocks.resize(count);
+        for(u32 i = 0; i < count; i++)
+        {
+            CacheBlock &blk = this->blocks[i];
+            blk.Block = (u64)-1;
+            blk.Sectors = 0;
+            blk.LastUse = 0;
+            blk.Dirty = false;
+            blk.Pinned = false;
+            blk.Data = (this->pool.data() + (i * bsize));
+        }
+        mutexInit(&this->lock);
+    }
+
+    BlockCache::~BlockCache()
+    {
+        this->Flush();
+    }
+
+    BlockDevice *BlockCache::GetDevice()
+    {
+        return this->dev;
+    }
+
+    CacheBlock *BlockCache::Find(u64 Block)
+    {
+        auto it = this->index.find(Block);
+        if(it == this->index.end()) return NULL;
+        CacheBlock *blk = &this->blocks[it->second];
+        blk->LastUse = ++this->tick;
+        return blk;
+    }
+
+    bool BlockCache::WriteBack(CacheBlock *Block)
+    {
+        if(!Block->Dirty) return true;
+        // Dirty neighbours go out in the same request, file data is usually written in long runs
+        std::vector<CacheBlock*> run = { Block };
+        while((run.size() < this->rahead) && (run.back()->Sectors == this->bsectors))
+        {
+            auto it = this->index.find(run.back()->Block + 1);
+            if(it == this->index.end()) break;
+            CacheBlock *next = &this->blocks[it->second];
+            if(!next->Dirty) break;
+            run.push_back(next);
+        }
+        this->dwrites++;
+        bool ok = false;
+        if(run.size() == 1) ok = this->dev->WriteSectors((Block->Block * this->bsectors), Block->Sectors, Block->Data);
+        else
+        {
+            u64 bsize = ((u64)this->bsectors * this->ssize);
+            u32 sectors = 0;
+            for(u32 i = 0; i < run.size(); i++)
+            {
+                memcpy(this->wstage.data() + (i * bsize), run[i]->Data, ((u64)run[i]->Sectors * this->ssize));
+                sectors += run[i]->Sectors;
+            }
+            ok = this->dev->WriteSectors((Block->Block * this->bsectors), sectors, this->wstage.data());
+        }
+        if(ok) for(auto blk: run) blk->Dirty = false;
+        return ok;
+    }
+
+    bool BlockCache::IsPinned(u64 Block)
+    {
+        return ((Block >= this->pinstart) && (Block < this->pinend) && (this->pinned < (this->blocks.size() / 2)));
+    }
+
+    CacheBlock *BlockCache::Evict()
+    {
+        CacheBlock *victim = NULL;
+        CacheBlock *oldest = NULL;
+        for(auto &blk: this->blocks)
+        {
+            if(blk.Sectors == 0) return &blk;
+            if((oldest == NULL) || (blk.LastUse < oldest->LastUse)) oldest = &blk;
+            if(!blk.Pinned && ((victim == NULL) || (blk.LastUse < victim->LastUse))) victim = &blk;
+        }
+        if(victim == NULL) victim = oldest;
+        if(!this->WriteBack(victim)) return NULL;
+        if(victim->Pinned) this->pinned--;
+        this->index.erase(victim->Block);
+        victim->Block = (u64)-1;
+        victim->Sectors = 0;
+        victim->Pinned = false;
+        return victim;
+    }
+
+    CacheBlock *BlockCache::Load(u64 Block)
+    {
+        u64 total = this->dev->GetSectorCount();
+        u64 first = (Block * this->bsectors);
+        if(first >= total) return NULL;
+        // Only sequential misses read ahead, and never over blocks already cached
+        u32 count = 1;
+        if(Block == (this->lastblock + 1)) while((count < this->rahead) && (((Block + count) * this->bsectors) < total) && (this->index.find(Block + count) == this->index.end())) count++;
+        u64 sectors = std::min((u64)count * this->bsectors, (total - first));
+        this->dreads++;
+        if(!this->dev->ReadSectors(first, sectors, this->stage.data())) return NULL;
+        CacheBlock *req = NULL;
+        for(u32 i = 0; i < count; i++)
+        {
+            CacheBlock *blk = this->Evict();
+            if(blk == NULL) return NULL;
+            u64 bfirst = (first + ((u64)i * this->bsectors));
+            blk->Block = (Block + i);
+            blk->Sectors = std::min((u64)this->bsectors, (total - bfirst));
+            blk->LastUse = ++this->tick;
+            blk->Dirty = false;
+            blk->Pinned = this->IsPinned(blk->Block);
+            if(blk->Pinned) this->pinned++;
+            memcpy(blk->Data, this->stage.data() + ((u64)i * this->bsectors * this->ssize), ((u64)blk->Sectors * this->ssize));
+            this->index[blk->Block] = (blk - this->blocks.data());
+            if(i == 0) req = blk;
+        }
+        return req;
+    }
+
+    bool BlockCache::Read(u64 Sector, u32 Count, u8 *Out)
+    {
+        mutexLock(&this->lock);
+        bool ok = true;
+        if(Count >= (this->bsectors * this->rahead))
+        {
+            // Big runs go straight into the caller's buffer, only newer cached data is patched over
+            this->dreads++;
+            ok = this->dev->ReadSectors(Sector, Count, Out);
+            if(ok) for(auto &blk: this->blocks)
+            {
+                if(!blk.Dirty) continue;
+                u64 bstart = (blk.Block * this->bsectors);
+                u64 start = std::max(bstart, Sector);
+                u64 end = std::min((bstart + blk.Sectors), (Sector + Count));
+                if(start < end) memcpy(Out + ((start - Sector) * this->ssize), blk.Data + ((start - bstart) * this->ssize), ((end - start) * this->ssize));
+            }
+            this->lastblock = ((Sector + Count - 1) / this->bsectors);
+        }
+        else
+        {
+            u64 sec = Sector;
+            u32 left = Count;
+            u8 *out = Out;
+            while(left > 0)
+            {
+                u64 bidx = (sec / this->bsectors);
+                CacheBlock *blk = this->Find(bidx);
+                if(blk == NULL) blk = this->Load(bidx);
+                u32 boff = (sec - (bidx * this->bsectors));
+                if((blk == NULL) || (boff >= blk->Sectors))
+                {
+                    ok = false;
+                    break;
+                }
+                u32 n = std::min(left, (blk->Sectors - boff));
+                memcpy(out, blk->Data + ((u64)boff * this->ssize), ((u64)n * this->ssize));
+                sec += n;
+                left -= n;
+                out += ((u64)n * this->ssize);
+                this->lastblock = bidx;
+            }
+        }
+        mutexUnlock(&this->lock);
+        return ok;
+    }
+
+    bool BlockCache::Write(u64 Sector, u32 Count, const u8 *Data)
+    {
+        if(this->dev->IsReadOnly()) return false;
+        mutexLock(&this->lock);
+        bool ok = true;
+        if(Count >= this->bsectors)
+        {
+            this->dwrites++;
+            ok = this->dev->WriteSectors(Sector, Count, Data);
+            if(ok) for(auto &blk: this->blocks)
+            {
+                if(blk.Sectors == 0) continue;
+                u64 bstart = (blk.Block * this->bsectors);
+                u64 start = std::max(bstart, Sector);
+                u64 end = std::min((bstart + blk.Sectors), (Sector + Count));
+                if(start < end) memcpy(blk.Data + ((start - bstart) * this->ssize), Data + ((start - Sector) * this->ssize), ((end - start) * this->ssize));
+            }
+        }
+        else
+        {
+            u64 sec = Sector;
+            u32 left = Count;
+            const u8 *in = Data;
+            while(left > 0)
+            {
+                u64 bidx = (sec / this->bsectors);
+                CacheBlock *blk = this->Find(bidx);
+                if(blk == NULL) blk = this->Load(bidx);
+                u32 boff = (sec - (bidx * this->bsectors));
+                if((blk == NULL) || (boff >= blk->Sectors))
+                {
+                    ok = false;
+                    break;
+                }
+                u32 n = std::min(left, (blk->Sectors - boff));
+                memcpy(blk->Data + ((u64)boff * this->ssize), in, ((u64)n * this->ssize));
+                blk->Dirty = true;
+                sec += n;
+                left -= n;
+                in += ((u64)n * this->ssize);
+                this->lastblock = bidx;
+            }
+        }
+        mutexUnlock(&this->lock);
+        return ok;
+    }
+
+    bool BlockCache::Flush()
+    {
+        mutexLock(&this->lock);
+        std::vector<CacheBlock*> dirty;
+        for(auto &blk: this->blocks) if(blk.Dirty) dirty.push_back(&blk);
+        std::sort(dirty.begin(), dirty.end(), [](CacheBlock *A, CacheBlock *B) { return (A->Block < B->Block); });
+        bool ok = true;
+        for(auto blk: dirty) if(!this->WriteBack(blk)) ok = false;
+        if(!this->dev->IsReadOnly() && !this->dev->Flush()) ok = false;
+        mutexUnlock(&this->lock);
+        return ok;
+    }
+
+    void BlockCache::Pin(u64 Sector, u64 Count)
+    {
+        mutexLock(&this->lock);
+        this->pinstart = (Sector / this->bsectors);
+        this->pinend = ((Sector + Count + this->bsectors - 1) / this->bsectors);
+        this->pinned = 0;
+        for(auto &blk: this->blocks)
+        {
+            blk.Pinned = ((blk.Sectors > 0) && this->IsPinned(blk.Block));
+            if(blk.Pinned) this->pinned++;
+        }
+        mutexUnlock(&this->lock);
+    }
+
+    u64 BlockCache::GetDeviceReads()
+    {
+        return this->dreads;
+    }
+
+    u64 BlockCache::GetDeviceWrites()
+    {
+        return this->dwrites;
+    }
+
+    bool MountDisk(u8 Drive, BlockDevice *Device)
+    {
+        if((Drive >= FF_VOLUMES) || (Device == NULL) || (Device->GetSectorCount() == 0)) return false;
+        UnmountDisk(Drive);
+        dcaches[Drive] = new BlockCache(Device);
+        return true;
+    }
+
+    void UnmountDisk(u8 Drive)
+    {
+        if(Drive >= FF_VOLUMES) return;
+        if(dcaches[Drive] != NULL) delete dcaches[Drive];
+        dcaches[Drive] = NULL;
+    }
+
+    BlockCache *GetDiskCache(u8 Drive)
+    {
+        if(Drive >= FF_VOLUMES) return NULL;
+        return dcaches[Drive];
+    }
+
+    void PinFATRegion(u8 Drive, FATFS *Volume)
+    {
+        BlockCache *cache = GetDiskCache(Drive);
+        if(cache != NULL) cache->Pin(Volume->fatbase, ((u64)Volume->fsize * Volume->n_fats));
+    }
+
+    FRESULT EnableFastSeek(FIL *File, std::vector<DWORD> &Table)
+    {
+        Table.assign(64, 0);
+        Table[0] = Table.size();
+        File->cltbl = Table.data();
+        FRESULT rc = f_lseek(File, CREATE_LINKMAP);
+        if(rc == FR_NOT_ENOUGH_CORE)
+        {
+            // FatFs reports the size it needs in the first item
+            u32 need = Table[0];
+            Table.assign(need, 0);
+            Table[0] = need;
+            File->cltbl = Table.data();
+            rc = f_lseek(File, CREATE_LINKMAP);
+        }
+        if(rc != FR_OK) File->cltbl = NULL;
+        return rc;
+    }
+}
\ No newline at end of file
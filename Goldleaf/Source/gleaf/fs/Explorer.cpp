@@ -1,5 +1,8 @@
 #include <gleaf/fs/Explorer.hpp>
+#include <gleaf/fs/HTTPExplorer.hpp>
+#include <gleaf/fs/FatFsExplorer.hpp>
 #include <gleaf/usb.hpp>
+#include <gleaf/err.hpp>
 #include <sys/stat.h>
 #include <dirent.h>
 #include <malloc.h>
@@ -16,6 +19,33 @@ namespace gleaf::fs
     static Explorer *enus = NULL;
     static Explorer *enss = NULL;
     static Explorer *epcdrv = NULL;
+    static HTTPExplorer *ehttp = NULL;
+
+    struct FatFsImage
+    {
+        Explorer *Host;
+        std::string Path;
+        FatFsExplorer *Image;
+    };
+
+    static std::vector<FatFsImage> efats;
+
+    // Images read their sectors through the host explorer, so they go before it does (nested ones first)
+    static void CloseFatFsExplorersOn(Explorer *Host)
+    {
+        std::vector<Explorer*> hosts = { Host };
+        std::vector<bool> drop(efats.size(), false);
+        for(u32 i = 0; i < efats.size(); i++) if(std::find(hosts.begin(), hosts.end(), efats[i].Host) != hosts.end())
+        {
+            drop[i] = true;
+            hosts.push_back(efats[i].Image);
+        }
+        for(s32 i = (efats.size() - 1); i >= 0; i--) if(drop[i])
+        {
+            delete efats[i].Image;
+            efats.erase(efats.begin() + i);
+        }
+    }
 
     bool InternalCaseCompare(std::string a, std::string b)
     {
@@ -38,6 +68,19 @@ namespace gleaf::fs
         return false;
     }
 
+    bool Explorer::IsReadOnly()
+    {
+        return false;
+    }
+
+    void Explorer::StartFile(std::string Path)
+    {
+    }
+
+    void Explorer::EndFile()
+    {
+    }
+
     void Explorer::SetNames(std::string MountName, std::string DisplayName)
     {
         this->dspname = DisplayName;
@@ -129,33 +172,59 @@ namespace gleaf::fs
         u8 *data = GetFileSystemOperationsBuffer();
         u64 szrem = fsize;
         u64 off = 0;
+        ex->StartFile(NewPath);
         while(szrem)
         {
             u64 rbytes = this->ReadFileBlock(path, off, std::min(szrem, rsize), data);
+            if(rbytes == 0) break;
             szrem -= rbytes;
             off += rbytes;
             ex->WriteFileBlock(NewPath, data, rbytes);
         }
+        ex->EndFile();
     }
 
-    void Explorer::CopyFileProgress(std::string Path, std::string NewPath, std::function<void(u8 Percentage)> Callback)
+    Result Explorer::CopyFileProgress(std::string Path, std::string NewPath, Progress &Prog)
     {
         std::string path = this->MakeFull(Path);
         auto ex = GetExplorerForMountName(GetPathRoot(NewPath));
         u64 fsize = this->GetFileSize(path);
+        if(Prog.GetBytesTotal() == 0) Prog.SetTotal(fsize, 1);
         u64 rsize = GetFileSystemOperationsBufferSize();
         u8 *data = GetFileSystemOperationsBuffer();
         u64 szrem = fsize;
         u64 off = 0;
+        ex->StartFile(NewPath);
         while(szrem)
         {
-            u64 rbytes = this->ReadFileBlock(path, off, std::min(szrem, rsize), data);
+            if(!Prog.CheckPoint())
+            {
+                ex->EndFile();
+                ex->DeleteFile(NewPath);
+                return err::Make(err::ErrorDescription::OperationCancelled);
+            }
+            u64 toread = std::min(szrem, rsize);
+            u64 rbytes = this->ReadFileBlock(path, off, toread, data);
+            // Remote sources return short reads when they fail: a truncated copy is never left behind as a finished one
+            if(rbytes != toread)
+            {
+                ex->EndFile();
+                ex->DeleteFile(NewPath);
+                return err::Make(err::ErrorDescription::ReadFailed);
+            }
+            if(ex->WriteFileBlock(NewPath, data, rbytes) != rbytes)
+            {
+                ex->EndFile();
+                ex->DeleteFile(NewPath);
+                return err::Make(err::ErrorDescription::WriteFailed);
+            }
             szrem -= rbytes;
             off += rbytes;
-            ex->WriteFileBlock(NewPath, data, rbytes);
-            u8 perc = ((double)((double)off / (double)fsize) * 100.0);
-            Callback(perc);
+            Prog.Advance(rbytes);
         }
+        ex->EndFile();
+        Prog.CompleteItem();
+        return 0;
     }
 
     void Explorer::CopyDirectory(std::string Dir, std::string NewDir)
@@ -179,25 +248,53 @@ namespace gleaf::fs
         }
     }
 
-    void Explorer::CopyDirectoryProgress(std::string Dir, std::string NewDir, std::function<void(u8 Percentage)> Callback)
+    Result Explorer::CopyDirectoryProgress(std::string Dir, std::string NewDir, Progress &Prog)
     {
         std::string dir = this->MakeFull(Dir);
         std::string ndir = this->MakeFull(NewDir);
-        this->CreateDirectory(ndir);
-        auto dirs = this->GetDirectories(dir);
+        // The whole tree is measured up front, so the item count does not grow as directories are reached
+        if(Prog.GetBytesTotal() == 0) Prog.SetTotal(this->GetDirectorySize(dir), this->GetDirectoryFileCount(dir));
+        std::vector<std::string> created;
+        Result rc = this->CopyDirectoryTree(dir, ndir, Prog, created);
+        if(rc != 0)
+        {
+            // A cancelled or failed copy removes what it wrote, newest first so its own directories are empty by then; directories that already existed stay
+            auto ex = GetExplorerForMountName(GetPathRoot(ndir));
+            for(auto it = created.rbegin(); it != created.rend(); it++)
+            {
+                if(ex->IsDirectory(*it)) ex->DeleteDirectorySingle(*it);
+                else ex->DeleteFile(*it);
+            }
+        }
+        return rc;
+    }
+
+    Result Explorer::CopyDirectoryTree(std::string Dir, std::string NewDir, Progress &Prog, std::vector<std::string> &Created)
+    {
+        auto ex = GetExplorerForMountName(GetPathRoot(NewDir));
+        if(!ex->IsDirectory(NewDir))
+        {
+            ex->CreateDirectory(NewDir);
+            Created.push_back(NewDir);
+        }
+        auto dirs = this->GetDirectories(Dir);
         if(!dirs.empty()) for(u32 i = 0; i < dirs.size(); i++)
         {
-            std::string dfrom = dir + "/" + dirs[i];
-            std::string dto = ndir + "/" + dirs[i];
-            this->CopyDirectoryProgress(dfrom, dto, Callback);
+            std::string dfrom = Dir + "/" + dirs[i];
+            std::string dto = NewDir + "/" + dirs[i];
+            Result rc = this->CopyDirectoryTree(dfrom, dto, Prog, Created);
+            if(rc != 0) return rc;
         }
-        auto files = this->GetFiles(dir);
+        auto files = this->GetFiles(Dir);
         if(!files.empty()) for(u32 i = 0; i < files.size(); i++)
         {
-            std::string dfrom = dir + "/" + files[i];
-            std::string dto = ndir + "/" + files[i];
-            this->CopyFileProgress(dfrom, dto, Callback);
+            std::string dfrom = Dir + "/" + files[i];
+            std::string dto = NewDir + "/" + files[i];
+            Result rc = this->CopyFileProgress(dfrom, dto, Prog);
+            if(rc != 0) return rc;
+            Created.push_back(dto);
         }
+        return 0;
     }
 
     bool Explorer::IsFileBinary(std::string Path)
@@ -374,6 +471,20 @@ namespace gleaf::fs
         return sz;
     }
 
+    u32 Explorer::GetDirectoryFileCount(std::string Path)
+    {
+        u32 count = 0;
+        std::string path = this->MakeFull(Path);
+        auto dirs = this->GetDirectories(path);
+        if(!dirs.empty()) for(u32 i = 0; i < dirs.size(); i++)
+        {
+            std::string pd = path + "/" + dirs[i];
+            count += this->GetDirectoryFileCount(pd);
+        }
+        count += this->GetFiles(path).size();
+        return count;
+    }
+
     void Explorer::DeleteDirectory(std::string Path)
     {
         std::string path = this->MakeFull(Path);
@@ -399,6 +510,16 @@ namespace gleaf::fs
         return (a < b);
     }
 
+    StdExplorer::StdExplorer()
+    {
+        this->wfile = NULL;
+    }
+
+    StdExplorer::~StdExplorer()
+    {
+        this->EndFile();
+    }
+
     std::vector<std::string> StdExplorer::GetDirectories(std::string Path)
     {
         std::vector<std::string> dirs;
@@ -511,10 +632,27 @@ namespace gleaf::fs
         return rsz;
     }
 
+    void StdExplorer::StartFile(std::string Path)
+    {
+        this->EndFile();
+        std::string path = this->MakeFull(Path);
+        this->wfile = fopen(path.c_str(), "wb");
+        if(this->wfile) this->wpath = path;
+    }
+
+    void StdExplorer::EndFile()
+    {
+        if(this->wfile) fclose(this->wfile);
+        this->wfile = NULL;
+        this->wpath = "";
+    }
+
+    // Outside a StartFile/EndFile pair every call rewrites the whole file
     u64 StdExplorer::WriteFileBlock(std::string Path, u8 *Data, u64 Size)
     {
         u64 wsz = 0;
         std::string path = this->MakeFull(Path);
+        if(this->wfile && (this->wpath == path)) return fwrite(Data, 1, Size, this->wfile);
         FILE *f = fopen(path.c_str(), "wb");
         if(f)
         {
@@ -626,6 +764,7 @@ namespace gleaf::fs
 
     void NANDExplorer::Close()
     {
+        this->EndFile();
         switch(this->part)
         {
             case Partition::PRODINFOF:
@@ -872,6 +1011,7 @@ namespace gleaf::fs
 
     void FileSystemExplorer::Close()
     {
+        this->EndFile();
         if(this->aclose) fsdevUnmountDevice(this->mntname.c_str());
         else fsdevDeleteDevice(this->mntname.c_str());
     }
@@ -923,6 +1063,7 @@ namespace gleaf::fs
         {
             if(epcdrv->GetMountName() != MountName)
             {
+                CloseFatFsExplorersOn(epcdrv);
                 delete epcdrv;
                 epcdrv = new USBPCDriveExplorer(mname);
                 if(MountName != mname)
@@ -936,6 +1077,54 @@ namespace gleaf::fs
         return epcdrv;
     }
 
+    Explorer *GetHTTPExplorer(std::string BaseURL)
+    {
+        std::string url = BaseURL;
+        while(!url.empty() && (url.back() == '/')) url.pop_back();
+        if(ehttp != NULL)
+        {
+            if(ehttp->GetBaseURL() == url) return ehttp;
+            CloseFatFsExplorersOn(ehttp);
+            delete ehttp;
+        }
+        ehttp = new HTTPExplorer(BaseURL);
+        return ehttp;
+    }
+
+    Explorer *GetFatFsImageExplorer(std::string Path, Explorer *Host)
+    {
+        for(auto &efat: efats) if((efat.Host == Host) && (efat.Path == Path)) return efat.Image;
+        // Every drive but the one kept for dumps is taken; mounted images stay alive until their host is replaced or Goldleaf exits
+        if(efats.size() >= (FF_VOLUMES - 1)) return NULL;
+        BlockDevice *dev = NULL;
+        if(dynamic_cast<StdExplorer*>(Host) != NULL)
+        {
+            FileBlockDevice *fdev = new FileBlockDevice(Path);
+            if(!fdev->IsOk())
+            {
+                delete fdev;
+                return NULL;
+            }
+            dev = fdev;
+        }
+        else dev = new ExplorerBlockDevice(Host, Path);
+        FatFsExplorer *efat = new FatFsExplorer(dev, GetFileName(Path));
+        if(!efat->IsOk())
+        {
+            delete efat;
+            return NULL;
+        }
+        efats.push_back({ Host, Path, efat });
+        return efat;
+    }
+
+    void CloseFatFsExplorers()
+    {
+        // Newest first: an image may be hosted inside an earlier one
+        for(auto it = efats.rbegin(); it != efats.rend(); it++) delete it->Image;
+        efats.clear();
+    }
+
     Explorer *GetExplorerForMountName(std::string MountName)
     {
         Explorer *ex = NULL;
@@ -945,6 +1134,8 @@ namespace gleaf::fs
         if(enus != NULL) if(enus->GetMountName() == MountName) return enus;
         if(enss != NULL) if(enss->GetMountName() == MountName) return enss;
         if(epcdrv != NULL) if(epcdrv->GetMountName() == MountName) return epcdrv;
+        if(ehttp != NULL) if(ehttp->GetMountName() == MountName) return ehttp;
+        for(auto &efat: efats) if(efat.Image->GetMountName() == MountName) return efat.Image;
         return ex;
     }
 }
\ No newline at end of file
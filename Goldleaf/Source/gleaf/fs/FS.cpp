@@ -17,7 +17,18 @@
 
 namespace gleaf::fs
 {
-    static u8 *opsbuf = NULL;
+    struct OperationsBuffer
+    {
+        u8 *Data = NULL;
+
+        ~OperationsBuffer()
+        {
+            if(Data != NULL) free(Data);
+        }
+    };
+
+    // One per thread, so a job copying on a worker never shares its buffer with the UI thread
+    static thread_local OperationsBuffer opsbuf;
     static size_t opsbufsz = 0x400000;
 
     bool Exists(std::string Path)
@@ -64,10 +75,10 @@ namespace gleaf::fs
         gexp->CopyFile(Path, NewPath);
     }
 
-    void CopyFileProgress(std::string Path, std::string NewPath, std::function<void(u8 Percentage)> Callback)
+    Result CopyFileProgress(std::string Path, std::string NewPath, Progress &Prog)
     {
         Explorer *gexp = GetExplorerForMountName(GetPathRoot(Path));
-        gexp->CopyFileProgress(Path, NewPath, Callback);
+        return gexp->CopyFileProgress(Path, NewPath, Prog);
     }
 
     void CopyDirectory(std::string Dir, std::string NewDir)
@@ -76,10 +87,10 @@ namespace gleaf::fs
         gexp->CopyDirectory(Dir, NewDir);
     }
 
-    void CopyDirectoryProgress(std::string Dir, std::string NewDir, std::function<void(u8 Percentage)> Callback)
+    Result CopyDirectoryProgress(std::string Dir, std::string NewDir, Progress &Prog)
     {
         Explorer *gexp = GetExplorerForMountName(GetPathRoot(Dir));
-        gexp->CopyDirectoryProgress(Dir, NewDir, Callback);
+        return gexp->CopyDirectoryProgress(Dir, NewDir, Prog);
     }
 
     Result DeleteFile(std::string Path)
@@ -402,8 +413,8 @@ namespace gleaf::fs
 
     u8 *GetFileSystemOperationsBuffer()
     {
-        if(opsbuf == NULL) opsbuf = (u8*)memalign(0x1000, opsbufsz);
-        return opsbuf;
+        if(opsbuf.Data == NULL) opsbuf.Data = (u8*)memalign(0x1000, opsbufsz);
+        return opsbuf.Data;
     }
 
     size_t GetFileSystemOperationsBufferSize()
@@ -0,0 +1,390 @@
+#include <gleaf/fs/FatFsExplorer.hpp>
+#include <algorithm>
+
+namespace gleaf::fs
+{
+    // Drive 0 stays reserved for the BIS partitions mounted while dumping
+    static bool dused[FF_VOLUMES] = { true };
+    static Mutex dlock;
+
+    static s32 AllocateDrive()
+    {
+        s32 drv = -1;
+        mutexLock(&dlock);
+        for(u32 i = 0; i < FF_VOLUMES; i++) if(!dused[i])
+        {
+            dused[i] = true;
+            drv = i;
+            break;
+        }
+        mutexUnlock(&dlock);
+        return drv;
+    }
+
+    static void FreeDrive(s32 Drive)
+    {
+        mutexLock(&dlock);
+        if((Drive > 0) && (Drive < FF_VOLUMES)) dused[Drive] = false;
+        mutexUnlock(&dlock);
+    }
+
+    static u64 WriteAll(FIL *File, u8 *Data, u64 Size)
+    {
+        u64 wsz = 0;
+        while(wsz < Size)
+        {
+            UINT bw = 0;
+            UINT towrite = (UINT)std::min(Size - wsz, (u64)0x40000000);
+            if(f_write(File, (Data + wsz), towrite, &bw) != FR_OK) break;
+            wsz += bw;
+            if(bw < towrite) break;
+        }
+        return wsz;
+    }
+
+    ExplorerBlockDevice::ExplorerBlockDevice(Explorer *Exp, std::string Path)
+    {
+        this->exp = Exp;
+        this->path = Path;
+        this->sectors = (Exp->GetFileSize(Path) / this->GetSectorSize());
+    }
+
+    bool ExplorerBlockDevice::ReadSectors(u64 Sector, u32 Count, u8 *Out)
+    {
+        if((Sector + Count) > this->sectors) return false;
+        u64 size = ((u64)Count * this->GetSectorSize());
+        return (this->exp->ReadFileBlock(this->path, (Sector * this->GetSectorSize()), size, Out) == size);
+    }
+
+    bool ExplorerBlockDevice::WriteSectors(u64 Sector, u32 Count, const u8 *Data)
+    {
+        return false;
+    }
+
+    u64 ExplorerBlockDevice::GetSectorCount()
+    {
+        return this->sectors;
+    }
+
+    bool ExplorerBlockDevice::IsReadOnly()
+    {
+        return true;
+    }
+
+    FatFsExplorer::FatFsExplorer(BlockDevice *Device, std::string DisplayName)
+    {
+        this->dev = Device;
+        this->ok = false;
+        this->rfile.obj.fs = NULL;
+        this->wfile.obj.fs = NULL;
+        mutexInit(&this->lock);
+        this->drive = AllocateDrive();
+        this->root = std::to_string(this->drive) + ":";
+        this->SetNames("fat" + std::to_string(this->drive), DisplayName);
+        if(this->drive < 0) return;
+        if(!MountDisk(this->drive, this->dev)) return;
+        if(f_mount(&this->fatfs, this->root.c_str(), 1) != FR_OK)
+        {
+            f_mount(NULL, this->root.c_str(), 0);
+            return;
+        }
+        PinFATRegion(this->drive, &this->fatfs);
+        this->ok = true;
+    }
+
+    FatFsExplorer::~FatFsExplorer()
+    {
+        this->Close();
+    }
+
+    bool FatFsExplorer::IsOk()
+    {
+        return this->ok;
+    }
+
+    std::string FatFsExplorer::GetLabel()
+    {
+        std::string label;
+        if(!this->ok) return label;
+        char lbl[34] = { 0 };
+        if(f_getlabel(this->root.c_str(), lbl, NULL) == FR_OK) label = std::string(lbl);
+        return label;
+    }
+
+    bool FatFsExplorer::IsReadOnly()
+    {
+        return ((this->dev == NULL) || this->dev->IsReadOnly());
+    }
+
+    void FatFsExplorer::StartFile(std::string Path)
+    {
+        if(!this->ok || this->dev->IsReadOnly()) return;
+        std::string path = this->FatPath(Path);
+        mutexLock(&this->lock);
+        this->CloseHandles();
+        if(f_open(&this->wfile, path.c_str(), (FA_WRITE | FA_CREATE_ALWAYS)) == FR_OK) this->wpath = path;
+        else this->wfile.obj.fs = NULL;
+        mutexUnlock(&this->lock);
+    }
+
+    void FatFsExplorer::EndFile()
+    {
+        if(!this->ok) return;
+        mutexLock(&this->lock);
+        if(this->wfile.obj.fs != NULL) f_close(&this->wfile);
+        this->wfile.obj.fs = NULL;
+        this->wpath.clear();
+        mutexUnlock(&this->lock);
+    }
+
+    std::string FatFsExplorer::FatPath(std::string Path)
+    {
+        return this->root + GetPathWithoutRoot(this->MakeFull(Path));
+    }
+
+    bool FatFsExplorer::IsRoot(std::string Path)
+    {
+        std::string path = GetPathWithoutRoot(this->MakeFull(Path));
+        return (path.find_first_not_of("/") == std::string::npos);
+    }
+
+    void FatFsExplorer::CloseHandles()
+    {
+        if(this->rfile.obj.fs != NULL) f_close(&this->rfile);
+        this->rfile.obj.fs = NULL;
+        this->rpath.clear();
+        this->rtable.clear();
+        if(this->wfile.obj.fs != NULL) f_close(&this->wfile);
+        this->wfile.obj.fs = NULL;
+        this->wpath.clear();
+    }
+
+    void FatFsExplorer::SyncWrite()
+    {
+        if(this->wfile.obj.fs != NULL) f_sync(&this->wfile);
+    }
+
+    std::vector<std::string> FatFsExplorer::GetDirectories(std::string Path)
+    {
+        std::vector<std::string> dirs;
+        if(!this->ok) return dirs;
+        mutexLock(&this->lock);
+        this->SyncWrite();
+        DIR dp;
+        if(f_opendir(&dp, this->FatPath(Path).c_str()) == FR_OK)
+        {
+            FILINFO info;
+            while((f_readdir(&dp, &info) == FR_OK) && (info.fname[0] != '\0')) if(info.fattrib & AM_DIR) dirs.push_back(std::string(info.fname));
+            f_closedir(&dp);
+        }
+        mutexUnlock(&this->lock);
+        return dirs;
+    }
+
+    std::vector<std::string> FatFsExplorer::GetFiles(std::string Path)
+    {
+        std::vector<std::string> files;
+        if(!this->ok) return files;
+        mutexLock(&this->lock);
+        this->SyncWrite();
+        DIR dp;
+        if(f_opendir(&dp, this->FatPath(Path).c_str()) == FR_OK)
+        {
+            FILINFO info;
+            while((f_readdir(&dp, &info) == FR_OK) && (info.fname[0] != '\0')) if(!(info.fattrib & AM_DIR)) files.push_back(std::string(info.fname));
+            f_closedir(&dp);
+        }
+        mutexUnlock(&this->lock);
+        return files;
+    }
+
+    bool FatFsExplorer::Exists(std::string Path)
+    {
+        if(!this->ok) return false;
+        if(this->IsRoot(Path)) return true;
+        mutexLock(&this->lock);
+        this->SyncWrite();
+        FILINFO info;
+        bool ex = (f_stat(this->FatPath(Path).c_str(), &info) == FR_OK);
+        mutexUnlock(&this->lock);
+        return ex;
+    }
+
+    bool FatFsExplorer::IsFile(std::string Path)
+    {
+        if(!this->ok || this->IsRoot(Path)) return false;
+        mutexLock(&this->lock);
+        this->SyncWrite();
+        FILINFO info;
+        bool isf = ((f_stat(this->FatPath(Path).c_str(), &info) == FR_OK) && !(info.fattrib & AM_DIR));
+        mutexUnlock(&this->lock);
+        return isf;
+    }
+
+    bool FatFsExplorer::IsDirectory(std::string Path)
+    {
+        if(!this->ok) return false;
+        if(this->IsRoot(Path)) return true;
+        mutexLock(&this->lock);
+        this->SyncWrite();
+        FILINFO info;
+        bool isd = ((f_stat(this->FatPath(Path).c_str(), &info) == FR_OK) && (info.fattrib & AM_DIR));
+        mutexUnlock(&this->lock);
+        return isd;
+    }
+
+    void FatFsExplorer::CreateFile(std::string Path)
+    {
+        if(!this->ok) return;
+        mutexLock(&this->lock);
+        this->CloseHandles();
+        FIL fp;
+        if(f_open(&fp, this->FatPath(Path).c_str(), (FA_WRITE | FA_CREATE_ALWAYS)) == FR_OK) f_close(&fp);
+        mutexUnlock(&this->lock);
+    }
+
+    void FatFsExplorer::CreateDirectory(std::string Path)
+    {
+        if(!this->ok) return;
+        mutexLock(&this->lock);
+        this->CloseHandles();
+        f_mkdir(this->FatPath(Path).c_str());
+        mutexUnlock(&this->lock);
+    }
+
+    void FatFsExplorer::RenameFile(std::string Path, std::string NewName)
+    {
+        if(!this->ok) return;
+        mutexLock(&this->lock);
+        this->CloseHandles();
+        f_rename(this->FatPath(Path).c_str(), this->FatPath(NewName).c_str());
+        mutexUnlock(&this->lock);
+    }
+
+    void FatFsExplorer::RenameDirectory(std::string Path, std::string NewName)
+    {
+        return this->RenameFile(Path, NewName);
+    }
+
+    void FatFsExplorer::DeleteFile(std::string Path)
+    {
+        if(!this->ok) return;
+        mutexLock(&this->lock);
+        this->CloseHandles();
+        f_unlink(this->FatPath(Path).c_str());
+        mutexUnlock(&this->lock);
+    }
+
+    void FatFsExplorer::DeleteDirectorySingle(std::string Path)
+    {
+        return this->DeleteFile(Path);
+    }
+
+    u64 FatFsExplorer::ReadFileBlock(std::string Path, u64 Offset, u64 Size, u8 *Out)
+    {
+        u64 rsz = 0;
+        if(!this->ok) return rsz;
+        std::string path = this->FatPath(Path);
+        mutexLock(&this->lock);
+        this->SyncWrite();
+        if(this->rpath != path)
+        {
+            if(this->rfile.obj.fs != NULL) f_close(&this->rfile);
+            this->rfile.obj.fs = NULL;
+            this->rpath.clear();
+            if(f_open(&this->rfile, path.c_str(), (FA_READ | FA_OPEN_EXISTING)) == FR_OK)
+            {
+                this->rpath = path;
+                EnableFastSeek(&this->rfile, this->rtable);
+            }
+            else this->rfile.obj.fs = NULL;
+        }
+        if(!this->rpath.empty() && (f_lseek(&this->rfile, Offset) == FR_OK))
+        {
+            while(rsz < Size)
+            {
+                UINT br = 0;
+                UINT toread = (UINT)std::min(Size - rsz, (u64)0x40000000);
+                if(f_read(&this->rfile, (Out + rsz), toread, &br) != FR_OK) break;
+                rsz += br;
+                if(br < toread) break;
+            }
+        }
+        mutexUnlock(&this->lock);
+        return rsz;
+    }
+
+    // Outside a StartFile/EndFile pair every call rewrites the whole file, as the stdio-backed explorers do
+    u64 FatFsExplorer::WriteFileBlock(std::string Path, u8 *Data, u64 Size)
+    {
+        u64 wsz = 0;
+        if(!this->ok || this->dev->IsReadOnly()) return wsz;
+        std::string path = this->FatPath(Path);
+        mutexLock(&this->lock);
+        if(!this->wpath.empty() && (this->wpath == path)) wsz = WriteAll(&this->wfile, Data, Size);
+        else
+        {
+            this->CloseHandles();
+            FIL fp;
+            if(f_open(&fp, path.c_str(), (FA_WRITE | FA_CREATE_ALWAYS)) == FR_OK)
+            {
+                wsz = WriteAll(&fp, Data, Size);
+                f_close(&fp);
+            }
+        }
+        mutexUnlock(&this->lock);
+        return wsz;
+    }
+
+    u64 FatFsExplorer::GetFileSize(std::string Path)
+    {
+        u64 sz = 0;
+        if(!this->ok) return sz;
+        mutexLock(&this->lock);
+        this->SyncWrite();
+        FILINFO info;
+        if(f_stat(this->FatPath(Path).c_str(), &info) == FR_OK) sz = info.fsize;
+        mutexUnlock(&this->lock);
+        return sz;
+    }
+
+    u64 FatFsExplorer::GetTotalSpace()
+    {
+        if(!this->ok) return 0;
+        return ((u64)(this->fatfs.n_fatent - 2) * this->fatfs.csize * this->dev->GetSectorSize());
+    }
+
+    u64 FatFsExplorer::GetFreeSpace()
+    {
+        u64 space = 0;
+        if(!this->ok) return space;
+        mutexLock(&this->lock);
+        this->SyncWrite();
+        DWORD clusters = 0;
+        FATFS *vol = NULL;
+        if(f_getfree(this->root.c_str(), &clusters, &vol) == FR_OK) space = ((u64)clusters * vol->csize * this->dev->GetSectorSize());
+        mutexUnlock(&this->lock);
+        return space;
+    }
+
+    void FatFsExplorer::Close()
+    {
+        if(this->dev == NULL) return;
+        mutexLock(&this->lock);
+        if(this->ok)
+        {
+            this->CloseHandles();
+            f_mount(NULL, this->root.c_str(), 0);
+            this->ok = false;
+        }
+        if(this->drive >= 0)
+        {
+            UnmountDisk(this->drive);
+            FreeDrive(this->drive);
+            this->drive = -1;
+        }
+        delete this->dev;
+        this->dev = NULL;
+        mutexUnlock(&this->lock);
+    }
+}
\ No newline at end of file
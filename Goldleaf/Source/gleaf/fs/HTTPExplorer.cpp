@@ -0,0 +1,330 @@
+#include <gleaf/fs/HTTPExplorer.hpp>
+#include <gleaf/net/Network.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+namespace gleaf::fs
+{
+    static const u64 ListingTTL = 5;
+    static const u64 WindowSize = 0x800000;
+    static const u64 SmallWindowSize = 0x10000;
+    static const u64 LargeReadSize = 0x100000;
+    static const u32 WindowConnections = 4;
+
+    static std::string EncodeURLPath(std::string Path)
+    {
+        static const char *hex = "0123456789ABCDEF";
+        std::string enc;
+        for(auto &ch: Path)
+        {
+            u8 c = (u8)ch;
+            if(isalnum(c) || (c == '/') || (c == '-') || (c == '_') || (c == '.') || (c == '~')) enc += (char)c;
+            else
+            {
+                enc += '%';
+                enc += hex[c >> 4];
+                enc += hex[c & 0xf];
+            }
+        }
+        return enc;
+    }
+
+    static std::string DecodeURLPath(std::string Path)
+    {
+        std::string dec;
+        for(u32 i = 0; i < Path.length(); i++)
+        {
+            if((Path[i] == '%') && ((i + 2) < Path.length()) && isxdigit((u8)Path[i + 1]) && isxdigit((u8)Path[i + 2]))
+            {
+                dec += (char)strtoul(Path.substr(i + 1, 2).c_str(), NULL, 16);
+                i += 2;
+            }
+            else dec += Path[i];
+        }
+        return dec;
+    }
+
+    static std::string DecodeHTMLEntities(std::string Text)
+    {
+        static const std::pair<std::string, std::string> ents[] = { { "&amp;", "&" }, { "&quot;", "\"" }, { "&#x27;", "'" }, { "&#39;", "'" }, { "&lt;", "<" }, { "&gt;", ">" } };
+        for(auto &ent: ents)
+        {
+            size_t pos = 0;
+            while((pos = Text.find(ent.first, pos)) != std::string::npos)
+            {
+                Text.replace(pos, ent.first.length(), ent.second);
+                pos += ent.second.length();
+            }
+        }
+        return Text;
+    }
+
+    // Any autoindex page works: every relative link to a direct child is an entry, a trailing slash marks directories
+    static void ParseListing(std::string HTML, HTTPListing &Out)
+    {
+        size_t pos = 0;
+        while((pos = HTML.find("href=", pos)) != std::string::npos)
+        {
+            pos += 5;
+            if(pos >= HTML.length()) break;
+            char quote = HTML[pos];
+            if((quote != '"') && (quote != '\'')) continue;
+            size_t end = HTML.find(quote, pos + 1);
+            if(end == std::string::npos) break;
+            std::string href = DecodeHTMLEntities(HTML.substr(pos + 1, end - pos - 1));
+            pos = end;
+            if(href.empty() || (href[0] == '?') || (href[0] == '#') || (href[0] == '/') || (href.find(":") != std::string::npos)) continue;
+            href = href.substr(0, href.find_first_of("?#"));
+            if(href.substr(0, 2) == "./") href = href.substr(2);
+            bool dir = (!href.empty() && (href.back() == '/'));
+            if(dir) href.pop_back();
+            if(href.empty() || (href == ".") || (href == "..") || (href.find('/') != std::string::npos)) continue;
+            std::string name = DecodeURLPath(href);
+            std::vector<std::string> &list = (dir ? Out.Directories : Out.Files);
+            if(std::find(list.begin(), list.end(), name) == list.end()) list.push_back(name);
+        }
+    }
+
+    static bool WindowHas(HTTPWindow &Window, std::string URL, u64 Offset)
+    {
+        return ((Window.URL == URL) && (Offset >= Window.Offset) && (Offset < (Window.Offset + Window.Size)));
+    }
+
+    HTTPExplorer::HTTPExplorer(std::string BaseURL)
+    {
+        this->base = BaseURL;
+        while(!this->base.empty() && (this->base.back() == '/')) this->base.pop_back();
+        this->cur.Offset = 0;
+        this->cur.Size = 0;
+        this->next.Offset = 0;
+        this->next.Size = 0;
+        this->cancel = false;
+        mutexInit(&this->clock);
+        mutexInit(&this->rlock);
+        this->SetNames("http", "HTTP");
+    }
+
+    HTTPExplorer::~HTTPExplorer()
+    {
+        this->Close();
+    }
+
+    std::string HTTPExplorer::GetBaseURL()
+    {
+        return this->base;
+    }
+
+    std::string HTTPExplorer::URLFor(std::string Path)
+    {
+        return (this->base + EncodeURLPath(GetPathWithoutRoot(this->MakeFull(Path))));
+    }
+
+    bool HTTPExplorer::IsReadOnly()
+    {
+        return true;
+    }
+
+    // GetDirectories, GetFiles and the Is* checks of one navigation all share a single fetch
+    HTTPListing HTTPExplorer::GetListing(std::string Path)
+    {
+        std::string path = this->MakeFull(Path);
+        while((path.length() > (this->mntname.length() + 2)) && (path.back() == '/')) path.pop_back();
+        u64 now = time(NULL);
+        mutexLock(&this->clock);
+        auto it = this->listings.find(path);
+        if((it != this->listings.end()) && ((now - it->second.Timestamp) < ListingTTL))
+        {
+            HTTPListing cached = it->second;
+            mutexUnlock(&this->clock);
+            return cached;
+        }
+        mutexUnlock(&this->clock);
+        std::string url = this->URLFor(path);
+        if(url.back() != '/') url += "/";
+        HTTPListing listing;
+        ParseListing(net::RetrieveContent(url), listing);
+        listing.Timestamp = now;
+        mutexLock(&this->clock);
+        this->listings[path] = listing;
+        mutexUnlock(&this->clock);
+        return listing;
+    }
+
+    std::vector<std::string> HTTPExplorer::GetDirectories(std::string Path)
+    {
+        return this->GetListing(Path).Directories;
+    }
+
+    std::vector<std::string> HTTPExplorer::GetFiles(std::string Path)
+    {
+        return this->GetListing(Path).Files;
+    }
+
+    bool HTTPExplorer::Exists(std::string Path)
+    {
+        return (this->IsDirectory(Path) || this->IsFile(Path));
+    }
+
+    bool HTTPExplorer::IsFile(std::string Path)
+    {
+        std::string path = this->MakeFull(Path);
+        if(path == (this->mntname + ":/")) return false;
+        std::string parent = path.substr(0, path.find_last_of("/"));
+        if(parent.back() == ':') parent += "/";
+        auto files = this->GetListing(parent).Files;
+        return (std::find(files.begin(), files.end(), GetFileName(path)) != files.end());
+    }
+
+    bool HTTPExplorer::IsDirectory(std::string Path)
+    {
+        std::string path = this->MakeFull(Path);
+        if(path == (this->mntname + ":/")) return true;
+        std::string parent = path.substr(0, path.find_last_of("/"));
+        if(parent.back() == ':') parent += "/";
+        auto dirs = this->GetListing(parent).Directories;
+        return (std::find(dirs.begin(), dirs.end(), GetFileName(path)) != dirs.end());
+    }
+
+    void HTTPExplorer::CreateFile(std::string Path)
+    {
+    }
+
+    void HTTPExplorer::CreateDirectory(std::string Path)
+    {
+    }
+
+    void HTTPExplorer::RenameFile(std::string Path, std::string NewName)
+    {
+    }
+
+    void HTTPExplorer::RenameDirectory(std::string Path, std::string NewName)
+    {
+    }
+
+    void HTTPExplorer::DeleteFile(std::string Path)
+    {
+    }
+
+    void HTTPExplorer::DeleteDirectorySingle(std::string Path)
+    {
+    }
+
+    bool HTTPExplorer::FillWindow(HTTPWindow &Window, std::string URL, u64 Offset, u64 Size)
+    {
+        Window.URL = URL;
+        Window.Offset = Offset;
+        if(Window.Data.size() < Size) Window.Data.resize(Size);
+        Window.Size = net::RetrieveRange(URL, Offset, Size, Window.Data.data(), WindowConnections, &this->cancel);
+        return (Window.Size > 0);
+    }
+
+    // The next window downloads while the caller consumes the current one (for installs, while it's written to the placeholder)
+    void HTTPExplorer::StartPrefetch(std::string URL, u64 Offset, u64 FileSize)
+    {
+        if(Offset >= FileSize) return;
+        u64 size = std::min(WindowSize, (FileSize - Offset));
+        this->next.URL = "";
+        this->next.Size = 0;
+        if(this->next.Data.size() < size) this->next.Data.resize(size);
+        this->prefetch.Run([this, URL, Offset, size]()
+        {
+            this->FillWindow(this->next, URL, Offset, size);
+        });
+    }
+
+    u64 HTTPExplorer::ReadFileBlock(std::string Path, u64 Offset, u64 Size, u8 *Out)
+    {
+        std::string path = this->MakeFull(Path);
+        u64 fsize = this->GetFileSize(path);
+        if(Offset >= fsize) return 0;
+        u64 rsize = std::min(Size, (fsize - Offset));
+        std::string url = this->URLFor(path);
+        u64 done = 0;
+        mutexLock(&this->rlock);
+        while(done < rsize)
+        {
+            u64 off = (Offset + done);
+            if(!WindowHas(this->cur, url, off))
+            {
+                bool seq = ((this->cur.URL == url) && (off == (this->cur.Offset + this->cur.Size)));
+                this->prefetch.Wait();
+                if(WindowHas(this->next, url, off))
+                {
+                    std::swap(this->cur, this->next);
+                    seq = true;
+                }
+                else
+                {
+                    // Small scattered reads (headers, tickets) shouldn't pull megabytes
+                    bool large = (seq || (rsize >= LargeReadSize));
+                    u64 wsize = std::min((large ? WindowSize : SmallWindowSize), (fsize - off));
+                    if(!this->FillWindow(this->cur, url, off, wsize)) break;
+                    seq = large;
+                }
+                if(seq) this->StartPrefetch(url, (this->cur.Offset + this->cur.Size), fsize);
+                if(!WindowHas(this->cur, url, off)) break;
+            }
+            u64 woff = (off - this->cur.Offset);
+            u64 csize = std::min((rsize - done), (this->cur.Size - woff));
+            memcpy(Out + done, this->cur.Data.data() + woff, csize);
+            done += csize;
+        }
+        mutexUnlock(&this->rlock);
+        return done;
+    }
+
+    u64 HTTPExplorer::WriteFileBlock(std::string Path, u8 *Data, u64 Size)
+    {
+        return 0;
+    }
+
+    u64 HTTPExplorer::GetFileSize(std::string Path)
+    {
+        std::string path = this->MakeFull(Path);
+        mutexLock(&this->clock);
+        auto it = this->sizes.find(path);
+        if(it != this->sizes.end())
+        {
+            u64 sz = it->second;
+            mutexUnlock(&this->clock);
+            return sz;
+        }
+        mutexUnlock(&this->clock);
+        u64 sz = 0;
+        bool ranges = false;
+        if(!net::RetrieveFileSize(this->URLFor(path), sz, ranges)) return 0;
+        mutexLock(&this->clock);
+        this->sizes[path] = sz;
+        mutexUnlock(&this->clock);
+        return sz;
+    }
+
+    u64 HTTPExplorer::GetTotalSpace()
+    {
+        return 0;
+    }
+
+    u64 HTTPExplorer::GetFreeSpace()
+    {
+        return 0;
+    }
+
+    void HTTPExplorer::Close()
+    {
+        // A prefetch still downloading would hold the close (and the explorer's deletion) for a whole window
+        this->cancel = true;
+        this->prefetch.Wait();
+        this->cancel = false;
+        mutexLock(&this->rlock);
+        this->cur = HTTPWindow();
+        this->next = HTTPWindow();
+        mutexUnlock(&this->rlock);
+        mutexLock(&this->clock);
+        this->listings.clear();
+        this->sizes.clear();
+        mutexUnlock(&this->clock);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include <gleaf/hactool/Diagnostics.hpp>
+#include <sys/iosupport.h>
+#include <cstdio>
+#include <algorithm>
+
+namespace gleaf::hactool
+{
+    static char diagbuf[DiagnosticsBufferSize];
+    static u64 diaghead = 0;
+    static u64 diagused = 0;
+    static Mutex diaglock;
+    static Mutex capturelock;
+    static const devoptab_t *prevout = NULL;
+    static const devoptab_t *preverr = NULL;
+    static bool capturing = false;
+
+    static ssize_t DiagnosticsWrite(struct _reent *r, void *fd, const char *ptr, size_t len)
+    {
+        mutexLock(&diaglock);
+        for(size_t i = 0; i < len; i++)
+        {
+            diagbuf[diaghead] = ptr[i];
+            diaghead = ((diaghead + 1) % DiagnosticsBufferSize);
+        }
+        diagused = std::min((diagused + len), DiagnosticsBufferSize);
+        mutexUnlock(&diaglock);
+        return len;
+    }
+
+    static const devoptab_t diagdotab =
+    {
+        .name = "diag",
+        .write_r = DiagnosticsWrite,
+    };
+
+    void BeginCapture()
+    {
+        mutexLock(&capturelock);
+        fflush(stdout);
+        fflush(stderr);
+        prevout = devoptab_list[STD_OUT];
+        preverr = devoptab_list[STD_ERR];
+        devoptab_list[STD_OUT] = &diagdotab;
+        devoptab_list[STD_ERR] = &diagdotab;
+        capturing = true;
+    }
+
+    void EndCapture()
+    {
+        fflush(stdout);
+        fflush(stderr);
+        devoptab_list[STD_OUT] = prevout;
+        devoptab_list[STD_ERR] = preverr;
+        capturing = false;
+        mutexUnlock(&capturelock);
+    }
+
+    void AppendDiagnostics(std::string Line)
+    {
+        Line += "\n";
+        DiagnosticsWrite(NULL, NULL, Line.c_str(), Line.length());
+    }
+
+    std::string GetDiagnostics()
+    {
+        mutexLock(&diaglock);
+        u64 start = ((diaghead + DiagnosticsBufferSize - diagused) % DiagnosticsBufferSize);
+        std::string diag;
+        diag.reserve(diagused);
+        for(u64 i = 0; i < diagused; i++) diag += diagbuf[(start + i) % DiagnosticsBufferSize];
+        mutexUnlock(&diaglock);
+        return diag;
+    }
+
+    void ClearDiagnostics()
+    {
+        mutexLock(&diaglock);
+        diaghead = 0;
+        diagused = 0;
+        mutexUnlock(&diaglock);
+    }
+
+    bool FlushDiagnostics(std::string Path)
+    {
+        std::string diag = GetDiagnostics();
+        FILE *f = fopen(Path.c_str(), "w");
+        if(!f) return false;
+        fwrite(diag.c_str(), 1, diag.length(), f);
+        fclose(f);
+        return true;
+    }
+
+    // At exit a capture may still be running on a worker, so stdio is handed back without waiting for its lock
+    void CloseDiagnostics()
+    {
+        if(capturing)
+        {
+            devoptab_list[STD_OUT] = prevout;
+            devoptab_list[STD_ERR] = preverr;
+            capturing = false;
+        }
+        if(!GetDiagnostics().empty()) FlushDiagnostics(GetDiagnosticsPath());
+    }
+
+    std::string GetDiagnosticsPath()
+    {
+        return "sdmc:/goldleaf/hactool.log";
+    }
+}
\ No newline at end of file
@@ -1,11 +1,21 @@
 #include "Hactool.hpp"
+#include <gleaf/hactool/Diagnostics.hpp>
 #include <iostream>
 #include <unistd.h>
 #include <fstream>
+#include <sys/stat.h>
 using namespace std;
 
 namespace gleaf::hactool
 {
+    static nca_keyset_t *keyscache = NULL;
+    static std::string keyspath;
+    static time_t keysmtime = 0;
+    static bool keysok = false;
+    static u64 keyshits = 0;
+    static u64 keyshitns = 0;
+    static Mutex keyslock;
+
     Extraction Extraction::MakeExeFs(std::string OutExeFs)
     {
         Extraction ext;
@@ -76,23 +86,94 @@ namespace gleaf::hactool
         return type;
     }
 
-    ProcessResult Process(std::string Input, Extraction Mode, ExtractionFormat Format, std::string KeyFile)
+    bool LoadKeyset(std::string KeyFile, hactool_settings_t *Settings)
+    {
+        pki_initialize_keyset(&Settings->keyset, KEYSET_RETAIL);
+        filepath_t keypath;
+        filepath_init(&keypath);
+        filepath_set(&keypath, KeyFile.c_str());
+        FILE *keyfile = NULL;
+        if(keypath.valid == VALIDITY_VALID) keyfile = os_fopen(keypath.os_path, OS_MODE_READ);
+        if(keyfile == NULL) return false;
+        extkeys_initialize_keyset(&Settings->keyset, keyfile);
+        if (Settings->has_sdseed) {
+            for (unsigned int key = 0; key < 2; key++) {
+                for (unsigned int i = 0; i < 0x20; i++) {
+                    Settings->keyset.sd_card_key_sources[key][i] ^= Settings->sdseed[i & 0xF];
+                }
+            }
+        }
+        pki_derive_keys(&Settings->keyset);
+        fclose(keyfile);
+        return true;
+    }
+
+    bool GetKeyset(std::string KeyFile, nca_keyset_t *Out)
+    {
+        u64 start = armTicksToNs(armGetSystemTick());
+        struct stat st;
+        time_t mtime = 0;
+        if(stat(KeyFile.c_str(), &st) == 0) mtime = st.st_mtime;
+        mutexLock(&keyslock);
+        if((keyscache == NULL) || (keyspath != KeyFile) || (keysmtime != mtime))
+        {
+            hactool_settings_t *sets = (hactool_settings_t*)calloc(1, sizeof(hactool_settings_t));
+            if(keyscache == NULL) keyscache = (nca_keyset_t*)malloc(sizeof(nca_keyset_t));
+            if((sets == NULL) || (keyscache == NULL))
+            {
+                free(sets);
+                mutexUnlock(&keyslock);
+                return false;
+            }
+            keysok = LoadKeyset(KeyFile, sets);
+            memcpy(keyscache, &sets->keyset, sizeof(nca_keyset_t));
+            free(sets);
+            keyspath = KeyFile;
+            keysmtime = mtime;
+            // Measured on the console: what a derivation costs against the cached lookups it saved since the last one
+            u64 derns = (armTicksToNs(armGetSystemTick()) - start);
+            std::string line = "Keyset derived from " + KeyFile + " in " + std::to_string(derns / 1000) + " us";
+            if(keyshits > 0) line += ", " + std::to_string(keyshits) + " cached lookups before it (" + std::to_string(keyshitns / keyshits / 1000) + " us each)";
+            AppendDiagnostics(line);
+            keyshits = 0;
+            keyshitns = 0;
+            memcpy(Out, keyscache, sizeof(nca_keyset_t));
+        }
+        else
+        {
+            memcpy(Out, keyscache, sizeof(nca_keyset_t));
+            keyshits++;
+            keyshitns += (armTicksToNs(armGetSystemTick()) - start);
+        }
+        bool ok = keysok;
+        mutexUnlock(&keyslock);
+        return ok;
+    }
+
+    void InvalidateKeyset()
+    {
+        mutexLock(&keyslock);
+        if(keyscache != NULL) free(keyscache);
+        keyscache = NULL;
+        keyspath = "";
+        keysok = false;
+        mutexUnlock(&keyslock);
+    }
+
+    static ProcessResult DoProcess(std::string Input, Extraction Mode, ExtractionFormat Format, std::string KeyFile)
     {
         ProcessResult proc = { NCAType::Data, 0, true };
         hactool_ctx_t tool_ctx;
         hactool_ctx_t base_ctx; /* Context for base NCA, if used. */
         nca_ctx_t nca_ctx;
-        filepath_t keypath;
         nca_init(&nca_ctx);
         memset(&tool_ctx, 0, sizeof(tool_ctx));
         memset(&base_ctx, 0, sizeof(base_ctx));
-        filepath_init(&keypath);
         nca_ctx.tool_ctx = &tool_ctx;
         nca_ctx.is_cli_target = true;
         nca_ctx.tool_ctx->file_type = FILETYPE_NCA;
         base_ctx.file_type = FILETYPE_NCA; 
         nca_ctx.tool_ctx->action = ACTION_INFO | ACTION_EXTRACT;
-        pki_initialize_keyset(&tool_ctx.settings.keyset, KEYSET_RETAIL);
         switch(Format)
         {
             case ExtractionFormat::XCI:
@@ -105,7 +186,6 @@ namespace gleaf::hactool
                 nca_ctx.tool_ctx->file_type = FILETYPE_PFS0;
                 break;
         }
-        filepath_set(&keypath, KeyFile.c_str());
         if(Mode.HasTitleKey)
         {
             parse_hex_key(nca_ctx.tool_ctx->settings.cli_titlekey, Mode.TitleKey.c_str(), 16);
@@ -125,21 +205,7 @@ namespace gleaf::hactool
         {
             filepath_set(&nca_ctx.tool_ctx->settings.section_dir_paths[2], Mode.Logo.c_str());
         }
-        FILE *keyfile = NULL;
-        if(keypath.valid == VALIDITY_VALID) keyfile = os_fopen(keypath.os_path, OS_MODE_READ);
-        if(keyfile != NULL)
-        {
-            extkeys_initialize_keyset(&tool_ctx.settings.keyset, keyfile);
-            if (tool_ctx.settings.has_sdseed) {
-                for (unsigned int key = 0; key < 2; key++) {
-                    for (unsigned int i = 0; i < 0x20; i++) {
-                        tool_ctx.settings.keyset.sd_card_key_sources[key][i] ^= tool_ctx.settings.sdseed[i & 0xF];
-                    }
-                }
-            }
-            pki_derive_keys(&tool_ctx.settings.keyset);
-            fclose(keyfile);
-        }
+        GetKeyset(KeyFile, &tool_ctx.settings.keyset);
 
         if ((tool_ctx.file = fopen(Input.c_str(), "rb")) == NULL && tool_ctx.file_type != FILETYPE_BOOT0) {
             fprintf(stderr, "unable to open: %s\n", strerror(errno));
@@ -387,4 +453,14 @@ namespace gleaf::hactool
         }
         return proc;
     }
+
+    ProcessResult Process(std::string Input, Extraction Mode, ExtractionFormat Format, std::string KeyFile)
+    {
+        BeginCapture();
+        ProcessResult proc = DoProcess(Input, Mode, Format, KeyFile);
+        EndCapture();
+        // Whatever hactool printed is only worth the SD write when something went wrong
+        if(!proc.Ok) FlushDiagnostics(GetDiagnosticsPath());
+        return proc;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,331 @@
+#include <gleaf/hactool/NCA.hpp>
+#include <algorithm>
+#include <cstring>
+#ifdef __ARM_FEATURE_CRYPTO
+#include <arm_neon.h>
+#endif
+
+namespace gleaf::hactool
+{
+    static void AesCryptBlocks(const mbedtls_aes_context *Context, bool Decrypt, const u8 *In, u8 *Out, u64 Blocks)
+    {
+        #ifdef __ARM_FEATURE_CRYPTO
+        const u8 *rk = (const u8*)Context->rk;
+        int nr = Context->nr;
+        uint8x16_t keys[15];
+        for(int i = 0; i <= nr; i++) keys[i] = vld1q_u8(rk + (i * 0x10));
+        for(u64 i = 0; i < Blocks; i++)
+        {
+            uint8x16_t st = vld1q_u8(In + (i * 0x10));
+            if(Decrypt)
+            {
+                for(int j = 0; j < (nr - 1); j++) st = vaesimcq_u8(vaesdq_u8(st, keys[j]));
+                st = veorq_u8(vaesdq_u8(st, keys[nr - 1]), keys[nr]);
+            }
+            else
+            {
+                for(int j = 0; j < (nr - 1); j++) st = vaesmcq_u8(vaeseq_u8(st, keys[j]));
+                st = veorq_u8(vaeseq_u8(st, keys[nr - 1]), keys[nr]);
+            }
+            vst1q_u8(Out + (i * 0x10), st);
+        }
+        #else
+        int mode = (Decrypt ? MBEDTLS_AES_DECRYPT : MBEDTLS_AES_ENCRYPT);
+        for(u64 i = 0; i < Blocks; i++) mbedtls_aes_crypt_ecb((mbedtls_aes_context*)Context, mode, In + (i * 0x10), Out + (i * 0x10));
+        #endif
+    }
+
+    void DecryptXTS(const u8 *Key, u8 *Data, u64 Size, u64 Sector, u64 SectorSize)
+    {
+        mbedtls_aes_context dctx;
+        mbedtls_aes_context tctx;
+        mbedtls_aes_init(&dctx);
+        mbedtls_aes_init(&tctx);
+        mbedtls_aes_setkey_dec(&dctx, Key, 128);
+        mbedtls_aes_setkey_enc(&tctx, Key + 0x10, 128);
+        u64 sectors = (Size / SectorSize);
+        for(u64 i = 0; i < sectors; i++)
+        {
+            u8 tweak[0x10] = { 0 };
+            u64 sec = (Sector + i);
+            for(int j = 0xf; j >= 0; j--)
+            {
+                tweak[j] = (u8)(sec & 0xff);
+                sec >>= 8;
+            }
+            AesCryptBlocks(&tctx, false, tweak, tweak, 1);
+            u8 *sdata = (Data + (i * SectorSize));
+            for(u64 j = 0; j < SectorSize; j += 0x10)
+            {
+                u8 *blk = (sdata + j);
+                for(u32 k = 0; k < 0x10; k++) blk[k] ^= tweak[k];
+                AesCryptBlocks(&dctx, true, blk, blk, 1);
+                for(u32 k = 0; k < 0x10; k++) blk[k] ^= tweak[k];
+                u8 carry = 0;
+                for(u32 k = 0; k < 0x10; k++)
+                {
+                    u8 ncarry = (tweak[k] >> 7);
+                    tweak[k] = ((tweak[k] << 1) | carry);
+                    carry = ncarry;
+                }
+                if(carry) tweak[0] ^= 0x87;
+            }
+        }
+        mbedtls_aes_free(&dctx);
+        mbedtls_aes_free(&tctx);
+    }
+
+    void DecryptCTR(const mbedtls_aes_context *Context, const u8 *Ctr, u64 Offset, u8 *Data, u64 Size)
+    {
+        u8 ks[0x400];
+        u8 ctr[0x10];
+        memcpy(ctr, Ctr, 0x8);
+        u64 blk = (Offset >> 4);
+        u64 done = 0;
+        while(done < Size)
+        {
+            u64 csize = std::min((u64)sizeof(ks), (Size - done));
+            u64 blocks = ((csize + 0xf) / 0x10);
+            for(u64 i = 0; i < blocks; i++)
+            {
+                u64 cblk = (blk + i);
+                for(int j = 0xf; j >= 0x8; j--)
+                {
+                    ctr[j] = (u8)(cblk & 0xff);
+                    cblk >>= 8;
+                }
+                memcpy(ks + (i * 0x10), ctr, 0x10);
+            }
+            AesCryptBlocks(Context, false, ks, ks, blocks);
+            for(u64 i = 0; i < csize; i++) Data[done + i] ^= ks[i];
+            blk += blocks;
+            done += csize;
+        }
+    }
+
+    void DecryptECB(const u8 *Key, u8 *Data, u64 Size)
+    {
+        mbedtls_aes_context ctx;
+        mbedtls_aes_init(&ctx);
+        mbedtls_aes_setkey_dec(&ctx, Key, 128);
+        AesCryptBlocks(&ctx, true, Data, Data, (Size / 0x10));
+        mbedtls_aes_free(&ctx);
+    }
+
+    NCA::NCA(NCAReader Reader, nca_keyset_t *Keyset)
+    {
+        this->reader = Reader;
+        this->Open(Keyset);
+    }
+
+    NCA::NCA(std::string Path, fs::Explorer *Exp, nca_keyset_t *Keyset)
+    {
+        this->reader = [Path, Exp](u64 Offset, u64 Size, u8 *Out) -> u64
+        {
+            return Exp->ReadFileBlock(Path, Offset, Size, Out);
+        };
+        this->Open(Keyset);
+    }
+
+    NCA::NCA(NcmContentStorage *Storage, NcmNcaId NCAId, nca_keyset_t *Keyset)
+    {
+        this->reader = [Storage, NCAId](u64 Offset, u64 Size, u8 *Out) -> u64
+        {
+            if(ncmContentStorageReadContentIdFile(Storage, &NCAId, Offset, Out, Size) != 0) return 0;
+            return Size;
+        };
+        this->Open(Keyset);
+    }
+
+    NCA::~NCA()
+    {
+        mbedtls_aes_free(&this->aes);
+    }
+
+    void NCA::Open(nca_keyset_t *Keyset)
+    {
+        this->keys = Keyset;
+        this->ok = false;
+        this->rid = false;
+        this->haskey = false;
+        mbedtls_aes_init(&this->aes);
+        memset(this->sections, 0, sizeof(this->sections));
+        memset(this->keyarea, 0, sizeof(this->keyarea));
+        u8 *hdr = (u8*)&this->header;
+        if(this->reader(0, sizeof(nca_header_t), hdr) != sizeof(nca_header_t)) return;
+        u8 rawfs[0x800];
+        memcpy(rawfs, hdr + 0x400, 0x800);
+        DecryptXTS(this->keys->header_key, hdr, sizeof(nca_header_t), 0, 0x200);
+        if(this->header.magic == MAGIC_NCA2)
+        {
+            for(u32 i = 0; i < 4; i++)
+            {
+                memcpy(hdr + 0x400 + (i * 0x200), rawfs + (i * 0x200), 0x200);
+                DecryptXTS(this->keys->header_key, hdr + 0x400 + (i * 0x200), 0x200, 0, 0x200);
+            }
+        }
+        else if(this->header.magic != MAGIC_NCA3) return;
+        for(u32 i = 0; i < 0x10; i++) if(this->header.rights_id[i] != 0)
+        {
+            this->rid = true;
+            break;
+        }
+        if(!this->rid)
+        {
+            memcpy(this->keyarea, this->header.encrypted_keys, 0x40);
+            DecryptECB(this->keys->key_area_keys[this->GetKeyGeneration()][this->header.kaek_ind], this->keyarea, 0x40);
+            this->SetSectionKey(this->keyarea + 0x20);
+        }
+        for(u32 i = 0; i < 4; i++)
+        {
+            nca_section_entry_t *ent = &this->header.section_entries[i];
+            if(ent->media_end_offset <= ent->media_start_offset) continue;
+            NCASection *sec = &this->sections[i];
+            sec->Present = true;
+            sec->Offset = ((u64)ent->media_start_offset * 0x200);
+            sec->Size = ((u64)(ent->media_end_offset - ent->media_start_offset) * 0x200);
+            sec->Crypto = static_cast<NCASectionCrypto>(this->header.fs_headers[i].crypt_type);
+            sec->FsType = this->header.fs_headers[i].fs_type;
+            for(u32 j = 0; j < 0x8; j++) sec->Ctr[j] = this->header.fs_headers[i].section_ctr[0x7 - j];
+        }
+        this->ok = true;
+    }
+
+    void NCA::SetSectionKey(const u8 *Key)
+    {
+        memcpy(this->seckey, Key, 0x10);
+        mbedtls_aes_setkey_enc(&this->aes, this->seckey, 128);
+        this->haskey = true;
+    }
+
+    bool NCA::IsOk()
+    {
+        return this->ok;
+    }
+
+    bool NCA::HasRightsId()
+    {
+        return this->rid;
+    }
+
+    nca_header_t *NCA::GetHeader()
+    {
+        return &this->header;
+    }
+
+    NCAType NCA::GetType()
+    {
+        return static_cast<NCAType>(this->header.content_type);
+    }
+
+    u64 NCA::GetApplicationId()
+    {
+        return this->header.title_id;
+    }
+
+    u64 NCA::GetSize()
+    {
+        return this->header.nca_size;
+    }
+
+    u8 NCA::GetKeyGeneration()
+    {
+        u8 gen = std::max(this->header.crypto_type, this->header.crypto_type2);
+        if(gen > 0) gen--;
+        return gen;
+    }
+
+    bool NCA::HasSection(u32 Index)
+    {
+        if(Index >= 4) return false;
+        return this->sections[Index].Present;
+    }
+
+    u64 NCA::GetSectionSize(u32 Index)
+    {
+        if(!this->HasSection(Index)) return 0;
+        return this->sections[Index].Size;
+    }
+
+    NCASectionCrypto NCA::GetSectionCrypto(u32 Index)
+    {
+        if(!this->HasSection(Index)) return NCASectionCrypto::None;
+        return this->sections[Index].Crypto;
+    }
+
+    u32 NCA::FindRomFsSection()
+    {
+        for(u32 i = 0; i < 4; i++) if(this->sections[i].Present && (this->sections[i].FsType == FS_TYPE_ROMFS)) return i;
+        return 4;
+    }
+
+    u64 NCA::ReadCTR(NCASection *Section, u64 Offset, u64 Size, u8 *Out)
+    {
+        u8 ctr[0x10];
+        memcpy(ctr, Section->Ctr, 0x10);
+        u64 abs = (Section->Offset + Offset);
+        u64 pad = (abs & 0xf);
+        u64 done = 0;
+        u8 blk[0x10];
+        if(pad)
+        {
+            u64 aoff = (abs - pad);
+            if(this->reader(aoff, 0x10, blk) != 0x10) return 0;
+            DecryptCTR(&this->aes, ctr, aoff, blk, 0x10);
+            done = std::min((0x10 - pad), Size);
+            memcpy(Out, blk + pad, done);
+        }
+        u64 body = ((Size - done) & ~0xf);
+        if(body)
+        {
+            u64 rbody = this->reader((abs + done), body, (Out + done));
+            DecryptCTR(&this->aes, ctr, (abs + done), (Out + done), rbody);
+            done += rbody;
+            if(rbody < body) return done;
+        }
+        if(done < Size)
+        {
+            if(this->reader((abs + done), 0x10, blk) != 0x10) return done;
+            DecryptCTR(&this->aes, ctr, (abs + done), blk, 0x10);
+            memcpy(Out + done, blk, (Size - done));
+            done = Size;
+        }
+        return done;
+    }
+
+    u64 NCA::ReadSectionBlock(u32 Index, u64 Offset, u64 Size, u8 *Out)
+    {
+        if(!this->ok || !this->HasSection(Index)) return 0;
+        u64 ssize = this->GetSectionSize(Index);
+        if(Offset >= ssize) return 0;
+        Size = std::min(Size, (ssize - Offset));
+        NCASection *sec = &this->sections[Index];
+        switch(sec->Crypto)
+        {
+            case NCASectionCrypto::None:
+                return this->reader((sec->Offset + Offset), Size, Out);
+            case NCASectionCrypto::XTS:
+            {
+                if(!this->haskey) return 0;
+                u64 soff = (Offset & ~0x1ff);
+                u64 ssz = (((Offset + Size + 0x1ff) & ~0x1ff) - soff);
+                u8 *tmp = (u8*)malloc(ssz);
+                if(tmp == NULL) return 0;
+                u64 rsize = this->reader((sec->Offset + soff), ssz, tmp);
+                DecryptXTS(this->keyarea, tmp, rsize, (soff / 0x200), 0x200);
+                u64 cpsize = 0;
+                if(rsize > (Offset - soff)) cpsize = std::min(Size, (rsize - (Offset - soff)));
+                memcpy(Out, tmp + (Offset - soff), cpsize);
+                free(tmp);
+                return cpsize;
+            }
+            case NCASectionCrypto::CTR:
+                if(!this->haskey) return 0;
+                return this->ReadCTR(sec, Offset, Size, Out);
+            default:
+                // Patch (BKTR) sections need their base NCA, which nothing reading installed contents has
+                return 0;
+        }
+        return 0;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,258 @@
+#include <gleaf/horizon/Integrity.hpp>
+#include <gleaf/horizon/NCAId.hpp>
+#include <gleaf/horizon/TaskPool.hpp>
+#include <gleaf/hactool.hpp>
+#include <gleaf/Application.hpp>
+#include <mbedtls/sha256.h>
+#include <algorithm>
+#include <fstream>
+
+namespace gleaf::horizon
+{
+    static bool ReadInstalledCNMT(NcmContentStorage *cst, NcmNcaId MetaId, nca_keyset_t *Keys, std::vector<ncm::HashedContentRecord> &Out)
+    {
+        hactool::NCA nca(cst, MetaId, Keys);
+        if(!nca.IsOk() || !nca.HasSection(0)) return false;
+        u64 pfsoff = nca.GetHeader()->fs_headers[0].pfs0_superblock.pfs0_offset;
+        pfs0_header_t phdr;
+        if(nca.ReadSectionBlock(0, pfsoff, sizeof(phdr), (u8*)&phdr) != sizeof(phdr)) return false;
+        if(phdr.magic != MAGIC_PFS0) return false;
+        u64 hsize = (sizeof(pfs0_header_t) + (phdr.num_files * sizeof(pfs0_file_entry_t)) + phdr.string_table_size);
+        u8 *hdata = (u8*)malloc(hsize);
+        if(hdata == NULL) return false;
+        bool ok = false;
+        if(nca.ReadSectionBlock(0, pfsoff, hsize, hdata) == hsize)
+        {
+            pfs0_file_entry_t *ents = (pfs0_file_entry_t*)(hdata + sizeof(pfs0_header_t));
+            char *strtab = (char*)(ents + phdr.num_files);
+            for(u32 i = 0; i < phdr.num_files; i++)
+            {
+                std::string name = std::string(strtab + ents[i].string_table_offset);
+                if((name.length() < 5) || (name.substr(name.length() - 5) != ".cnmt")) continue;
+                u8 *cnmt = (u8*)malloc(ents[i].size);
+                if(cnmt == NULL) break;
+                if(nca.ReadSectionBlock(0, (pfsoff + hsize + ents[i].offset), ents[i].size, cnmt) == ents[i].size)
+                {
+                    ncm::ContentMeta cmeta(cnmt, ents[i].size);
+                    Out = cmeta.GetHashedContentRecords();
+                    ok = true;
+                }
+                free(cnmt);
+                break;
+            }
+        }
+        free(hdata);
+        return ok;
+    }
+
+    IntegrityScanner::IntegrityScanner(std::vector<Title> Titles, u32 Workers)
+    {
+        this->titles = Titles;
+        this->workers = std::max(Workers, (u32)1);
+        this->done = 0;
+        this->prog = NULL;
+        mutexInit(&this->lock);
+    }
+
+    IntegrityScanner::~IntegrityScanner()
+    {
+        this->jobs.clear();
+        this->verified.clear();
+    }
+
+    void IntegrityScanner::LoadProgress()
+    {
+        this->verified.clear();
+        std::ifstream ifs(GetIntegrityProgressPath());
+        if(!ifs.good()) return;
+        std::string line;
+        while(std::getline(ifs, line)) if(!line.empty()) this->verified.push_back(line);
+        ifs.close();
+    }
+
+    void IntegrityScanner::SaveVerified(const NcmNcaId &NCAId)
+    {
+        FILE *f = fopen(GetIntegrityProgressPath().c_str(), "a");
+        if(!f) return;
+        std::string id = GetStringFromNCAId(NCAId) + "\n";
+        fwrite(id.c_str(), 1, id.length(), f);
+        fclose(f);
+    }
+
+    void IntegrityScanner::ResetProgress()
+    {
+        remove(GetIntegrityProgressPath().c_str());
+        this->verified.clear();
+    }
+
+    // Hashes at most 16MB of one content, so a single big NCA never holds a pool worker for the whole scan
+    void IntegrityScanner::VerifyChunk(u32 Index)
+    {
+        IntegrityJob *job = &this->jobs[Index];
+        ContentVerification *cnt = &job->Content;
+        if(!job->Started)
+        {
+            mbedtls_sha256_init(&job->Sha);
+            mbedtls_sha256_starts_ret(&job->Sha, 0);
+            job->Started = true;
+        }
+        u64 bsize = 0x100000;
+        u64 end = std::min(cnt->Size, (job->Offset + 0x1000000));
+        bool rok = false;
+        NcmContentStorage cst;
+        if(ncmOpenContentStorage(static_cast<FsStorageId>(cnt->Location), &cst) == 0)
+        {
+            u8 *buf = (u8*)malloc(bsize);
+            rok = (buf != NULL);
+            while(rok && (job->Offset < end))
+            {
+                if(!this->prog->CheckPoint()) break;
+                u64 rsize = std::min(bsize, (end - job->Offset));
+                if(ncmContentStorageReadContentIdFile(&cst, &cnt->NCAId, job->Offset, buf, rsize) != 0)
+                {
+                    rok = false;
+                    break;
+                }
+                mbedtls_sha256_update_ret(&job->Sha, buf, rsize);
+                job->Offset += rsize;
+                mutexLock(&this->lock);
+                this->done += rsize;
+                mutexUnlock(&this->lock);
+            }
+            free(buf);
+            serviceClose(&cst.s);
+        }
+        if(!rok || (job->Offset >= cnt->Size))
+        {
+            u8 hash[0x20];
+            mbedtls_sha256_finish_ret(&job->Sha, hash);
+            mbedtls_sha256_free(&job->Sha);
+            job->Started = false;
+            // A storage that can't be opened or read is left as a read error, not a clean one
+            cnt->Status = ContentIntegrity::ReadError;
+            if(rok)
+            {
+                bool match = (job->HasHash ? (memcmp(hash, job->Hash, 0x20) == 0) : (memcmp(hash, cnt->NCAId.c, 0x10) == 0));
+                cnt->Status = (match ? ContentIntegrity::Ok : ContentIntegrity::HashMismatch);
+            }
+            mutexLock(&this->lock);
+            if(cnt->Status == ContentIntegrity::Ok) this->SaveVerified(cnt->NCAId);
+            this->done += (cnt->Size - job->Offset);
+            job->Done = true;
+            mutexUnlock(&this->lock);
+        }
+        mutexLock(&this->lock);
+        job->Running = false;
+        mutexUnlock(&this->lock);
+    }
+
+    std::vector<ContentVerification> IntegrityScanner::Scan(Progress &Prog)
+    {
+        this->LoadProgress();
+        this->jobs.clear();
+        this->done = 0;
+        this->prog = &Prog;
+        nca_keyset_t *keys = (nca_keyset_t*)malloc(sizeof(nca_keyset_t));
+        // Without keys every content is still checked, against its NCA id instead of the CNMT hash
+        bool haskeys = ((keys != NULL) && hactool::GetKeyset(GetKeyFilePath(), keys));
+        u64 total = 0;
+        for(u32 i = 0; i < this->titles.size(); i++)
+        {
+            Title &tit = this->titles[i];
+            TitleContents cnts = tit.GetContents();
+            std::vector<ncm::HashedContentRecord> hrecs;
+            NcmContentStorage cst;
+            bool reachable = (ncmOpenContentStorage(static_cast<FsStorageId>(tit.Location), &cst) == 0);
+            if(reachable)
+            {
+                if(haskeys && !cnts.Meta.Empty) ReadInstalledCNMT(&cst, cnts.Meta.NCAId, keys, hrecs);
+                serviceClose(&cst.s);
+            }
+            ContentId ids[] = { cnts.Meta, cnts.Program, cnts.Data, cnts.Control, cnts.HtmlDocument, cnts.LegalInfo };
+            for(u32 j = 0; j < 6; j++)
+            {
+                if(ids[j].Empty) continue;
+                IntegrityJob job;
+                memset(&job, 0, sizeof(job));
+                job.Content.ApplicationId = tit.ApplicationId;
+                job.Content.Type = ids[j].Type;
+                job.Content.NCAId = ids[j].NCAId;
+                job.Content.Location = ids[j].Location;
+                job.Content.Size = ids[j].Size;
+                job.Content.Status = ContentIntegrity::Ok;
+                for(u32 k = 0; k < hrecs.size(); k++) if(memcmp(hrecs[k].Record.NCAId.c, ids[j].NCAId.c, 0x10) == 0)
+                {
+                    memcpy(job.Hash, hrecs[k].Hash, 0x20);
+                    job.HasHash = true;
+                    break;
+                }
+                std::string sid = GetStringFromNCAId(ids[j].NCAId);
+                job.Skip = (std::find(this->verified.begin(), this->verified.end(), sid) != this->verified.end());
+                if(!reachable)
+                {
+                    // Nothing to hash, but it's reported like any other unreadable content
+                    job.Content.Status = ContentIntegrity::ReadError;
+                    job.Skip = true;
+                }
+                if(!job.Skip) total += job.Content.Size;
+                this->jobs.push_back(job);
+            }
+        }
+        free(keys);
+        u32 count = 0;
+        for(u32 i = 0; i < this->jobs.size(); i++) if(!this->jobs[i].Skip) count++;
+        Prog.SetTotal(total, count);
+        // Leave a worker free for texture decodes and other short tasks
+        u32 pworkers = GetTaskPoolWorkerCount();
+        u32 cap = std::max((u32)1, std::min(this->workers, ((pworkers > 1) ? (pworkers - 1) : (u32)1)));
+        TaskGroup grp;
+        while(true)
+        {
+            bool cancel = Prog.IsCancelled();
+            bool left = false;
+            u32 running = 0;
+            std::vector<u32> launch;
+            mutexLock(&this->lock);
+            for(u32 i = 0; i < this->jobs.size(); i++) if(this->jobs[i].Running) running++;
+            for(u32 i = 0; i < this->jobs.size(); i++)
+            {
+                IntegrityJob &job = this->jobs[i];
+                if(job.Skip || job.Done) continue;
+                left = true;
+                if(cancel || job.Running || (running >= cap)) continue;
+                job.Running = true;
+                running++;
+                launch.push_back(i);
+            }
+            u64 cdone = this->done;
+            mutexUnlock(&this->lock);
+            for(u32 i = 0; i < launch.size(); i++) grp.Run(std::bind(&IntegrityScanner::VerifyChunk, this, launch[i]));
+            Prog.SetDone(cdone);
+            if((!left || cancel) && (running == 0)) break;
+            svcSleepThread(10000000);
+        }
+        grp.Wait();
+        Prog.SetDone(this->done);
+        Prog.Flush();
+        for(u32 i = 0; i < this->jobs.size(); i++) if(this->jobs[i].Started)
+        {
+            mbedtls_sha256_free(&this->jobs[i].Sha);
+            this->jobs[i].Started = false;
+        }
+        std::vector<ContentVerification> res;
+        if(Prog.IsCancelled())
+        {
+            // Keep the verified log so the next scan resumes where this one stopped
+            for(u32 i = 0; i < this->jobs.size(); i++) if(this->jobs[i].Skip || this->jobs[i].Done) res.push_back(this->jobs[i].Content);
+            return res;
+        }
+        for(u32 i = 0; i < this->jobs.size(); i++) res.push_back(this->jobs[i].Content);
+        this->ResetProgress();
+        return res;
+    }
+
+    std::string GetIntegrityProgressPath()
+    {
+        return "sdmc:/goldleaf/verify.log";
+    }
+}
\ No newline at end of file
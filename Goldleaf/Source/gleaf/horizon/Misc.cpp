@@ -14,20 +14,28 @@ namespace gleaf::horizon
     static GpioPadSession volup;
     static GpioPadSession voldown;
 
-    Thread::Thread(ThreadFunc Callback)
+    Thread::Thread(ThreadFunc Callback, size_t StackSize, int CpuId, int Priority)
     {
         this->tcb = Callback;
+        this->stacksz = StackSize;
+        this->cpuid = CpuId;
+        this->prio = Priority;
+        this->created = false;
     }
 
     Thread::~Thread()
     {
-        threadClose(&this->nth);
+        if(this->created) threadClose(&this->nth);
     }
 
     Result Thread::Start(void *Args)
     {
-        Result rc = threadCreate(&this->nth, this->tcb, Args, 0x2000, 0x2b, -2);
-        if(rc == 0) rc = threadStart(&this->nth);
+        Result rc = threadCreate(&this->nth, this->tcb, Args, this->stacksz, this->prio, this->cpuid);
+        if(rc == 0)
+        {
+            this->created = true;
+            rc = threadStart(&this->nth);
+        }
         return rc;
     }
 
@@ -0,0 +1,400 @@
+#include <gleaf/horizon/TaskPool.hpp>
+#include <gleaf/horizon/Misc.hpp>
+#include <mbedtls/sha256.h>
+#include <deque>
+#include <algorithm>
+#include <fstream>
+#include <cstring>
+
+namespace gleaf::horizon
+{
+    struct PoolTask
+    {
+        std::function<void()> Task;
+        TaskGroup *Group;
+    };
+
+    struct TaskQueue
+    {
+        std::deque<PoolTask> Tasks;
+        Mutex Lock;
+    };
+
+    // Submitting and popping hold it for reading; starting and stopping hold it for writing, so no task is queued into a stopped pool
+    static RwLock tplock;
+    static std::vector<TaskQueue*> tpqueues;
+    static std::vector<Thread*> tpthreads;
+    static std::atomic<bool> tprunning(false);
+    static std::atomic<u32> tpnext(0);
+    static Semaphore tpsem;
+    static thread_local s32 tpindex = -1;
+
+    static bool PopFromQueue(TaskQueue *Queue, bool Newest, TaskGroup *Group, PoolTask &Out)
+    {
+        bool got = false;
+        mutexLock(&Queue->Lock);
+        if(Group == NULL)
+        {
+            if(!Queue->Tasks.empty())
+            {
+                Out = (Newest ? Queue->Tasks.back() : Queue->Tasks.front());
+                if(Newest) Queue->Tasks.pop_back();
+                else Queue->Tasks.pop_front();
+                got = true;
+            }
+        }
+        else for(auto it = Queue->Tasks.begin(); it != Queue->Tasks.end(); it++) if(it->Group == Group)
+        {
+            Out = *it;
+            Queue->Tasks.erase(it);
+            got = true;
+            break;
+        }
+        mutexUnlock(&Queue->Lock);
+        return got;
+    }
+
+    // Owners take their newest task (still hot in cache), thieves take the oldest one of another worker; a group only takes its own tasks
+    static bool PopTask(s32 Index, TaskGroup *Group, PoolTask &Out)
+    {
+        bool got = false;
+        rwlockReadLock(&tplock);
+        u32 count = tpqueues.size();
+        if(count > 0)
+        {
+            if(Index >= 0) got = PopFromQueue(tpqueues[Index], true, Group, Out);
+            u32 start = ((Index >= 0) ? (Index + 1) : tpnext.load());
+            for(u32 i = 0; (i < count) && !got; i++) got = PopFromQueue(tpqueues[(start + i) % count], false, Group, Out);
+        }
+        rwlockReadUnlock(&tplock);
+        return got;
+    }
+
+    static void SubmitPoolTask(std::function<void()> Task, TaskGroup *Group)
+    {
+        rwlockReadLock(&tplock);
+        if(!tprunning || tpqueues.empty())
+        {
+            rwlockReadUnlock(&tplock);
+            Task();
+            return;
+        }
+        u32 idx = ((tpindex >= 0) ? tpindex : (tpnext.fetch_add(1) % tpqueues.size()));
+        TaskQueue *q = tpqueues[idx];
+        mutexLock(&q->Lock);
+        q->Tasks.push_back({ Task, Group });
+        mutexUnlock(&q->Lock);
+        rwlockReadUnlock(&tplock);
+        semaphoreSignal(&tpsem);
+    }
+
+    static void TaskWorker(void *Args)
+    {
+        s32 idx = (s32)(uintptr_t)Args;
+        tpindex = idx;
+        while(true)
+        {
+            PoolTask task;
+            if(PopTask(idx, NULL, task))
+            {
+                task.Task();
+                continue;
+            }
+            if(!tprunning) break;
+            semaphoreWait(&tpsem);
+        }
+    }
+
+    TaskGroup::TaskGroup()
+    {
+        this->pending = 0;
+    }
+
+    TaskGroup::~TaskGroup()
+    {
+        this->Wait();
+    }
+
+    void TaskGroup::Run(std::function<void()> Task)
+    {
+        this->pending.fetch_add(1);
+        SubmitPoolTask([this, Task]()
+        {
+            Task();
+            this->pending.fetch_sub(1);
+        }, this);
+    }
+
+    void TaskGroup::Wait()
+    {
+        while(this->pending.load() > 0)
+        {
+            PoolTask task;
+            if(PopTask(tpindex, this, task)) task.Task();
+            else svcSleepThread(100000);
+        }
+    }
+
+    bool TaskGroup::IsDone()
+    {
+        return (this->pending.load() == 0);
+    }
+
+    TaskGraph::TaskGraph()
+    {
+    }
+
+    TaskGraph::~TaskGraph()
+    {
+        for(u32 i = 0; i < this->nodes.size(); i++) delete this->nodes[i];
+    }
+
+    u32 TaskGraph::Add(std::function<void()> Task)
+    {
+        TaskNode *node = new TaskNode();
+        node->Task = Task;
+        node->Dependencies = 0;
+        node->Remaining = 0;
+        this->nodes.push_back(node);
+        return (this->nodes.size() - 1);
+    }
+
+    void TaskGraph::Depend(u32 Task, u32 On)
+    {
+        if((Task >= this->nodes.size()) || (On >= this->nodes.size()) || (Task == On)) return;
+        this->nodes[On]->Next.push_back(Task);
+        this->nodes[Task]->Dependencies++;
+    }
+
+    void TaskGraph::Run()
+    {
+        TaskGroup grp;
+        for(u32 i = 0; i < this->nodes.size(); i++) this->nodes[i]->Remaining = this->nodes[i]->Dependencies;
+        for(u32 i = 0; i < this->nodes.size(); i++) if(this->nodes[i]->Dependencies == 0) this->Submit(i, &grp);
+        grp.Wait();
+    }
+
+    void TaskGraph::Submit(u32 Index, TaskGroup *Group)
+    {
+        Group->Run([this, Index, Group]()
+        {
+            TaskNode *node = this->nodes[Index];
+            node->Task();
+            // Successors are queued before this task counts as done, so the group can't drain early
+            for(u32 i = 0; i < node->Next.size(); i++)
+            {
+                u32 next = node->Next[i];
+                if(this->nodes[next]->Remaining.fetch_sub(1) == 1) this->Submit(next, Group);
+            }
+        });
+    }
+
+    void StartTaskPool(u32 Workers)
+    {
+        rwlockWriteLock(&tplock);
+        if(tprunning)
+        {
+            rwlockWriteUnlock(&tplock);
+            return;
+        }
+        u64 mask = GetUsableCoreMask();
+        std::vector<int> cores;
+        for(u32 i = 0; i < 64; i++) if(mask & (1ul << i)) cores.push_back(i);
+        u32 count = ((Workers > 0) ? Workers : cores.size());
+        semaphoreInit(&tpsem, 0);
+        tprunning = true;
+        for(u32 i = 0; i < count; i++)
+        {
+            TaskQueue *q = new TaskQueue();
+            mutexInit(&q->Lock);
+            tpqueues.push_back(q);
+        }
+        for(u32 i = 0; i < count; i++)
+        {
+            // Below the UI thread (0x2c): background work may use every core, but never delays a frame
+            Thread *thd = new Thread(&TaskWorker, 0x20000, cores[i % cores.size()], 0x2d);
+            if(thd->Start((void*)(uintptr_t)i) == 0) tpthreads.push_back(thd);
+            else delete thd;
+        }
+        rwlockWriteUnlock(&tplock);
+        if(tpthreads.empty()) StopTaskPool();
+    }
+
+    void StopTaskPool()
+    {
+        rwlockWriteLock(&tplock);
+        tprunning = false;
+        rwlockWriteUnlock(&tplock);
+        for(u32 i = 0; i < tpthreads.size(); i++) semaphoreSignal(&tpsem);
+        for(u32 i = 0; i < tpthreads.size(); i++)
+        {
+            tpthreads[i]->Join();
+            delete tpthreads[i];
+        }
+        tpthreads.clear();
+        // Leftovers run outside the lock: anything they submit now runs inline
+        std::vector<PoolTask> left;
+        rwlockWriteLock(&tplock);
+        for(u32 i = 0; i < tpqueues.size(); i++)
+        {
+            left.insert(left.end(), tpqueues[i]->Tasks.begin(), tpqueues[i]->Tasks.end());
+            delete tpqueues[i];
+        }
+        tpqueues.clear();
+        rwlockWriteUnlock(&tplock);
+        for(u32 i = 0; i < left.size(); i++) left[i].Task();
+    }
+
+    u32 GetTaskPoolWorkerCount()
+    {
+        return tpthreads.size();
+    }
+
+    u64 GetUsableCoreMask()
+    {
+        u64 mask = 0;
+        if((svcGetInfo(&mask, InfoType_CoreMask, CUR_PROCESS_HANDLE, 0) != 0) || (mask == 0)) mask = 0x7;
+        return mask;
+    }
+
+    void SubmitTask(std::function<void()> Task)
+    {
+        SubmitPoolTask(Task, NULL);
+    }
+
+    bool RunPendingTask()
+    {
+        PoolTask task;
+        if(!PopTask(tpindex, NULL, task)) return false;
+        task.Task();
+        return true;
+    }
+
+    void ParallelFor(u64 Begin, u64 End, u64 Grain, std::function<void(u64 Begin, u64 End)> Body)
+    {
+        if(End <= Begin) return;
+        if(Grain == 0) Grain = 1;
+        TaskGroup grp;
+        for(u64 i = Begin; i < End; i += Grain)
+        {
+            u64 end = std::min(End, (i + Grain));
+            // The calling thread takes the last range itself instead of idling
+            if(end == End)
+            {
+                Body(i, end);
+                break;
+            }
+            grp.Run([&Body, i, end]()
+            {
+                Body(i, end);
+            });
+        }
+        grp.Wait();
+    }
+
+    static u64 GetNanoseconds()
+    {
+        return armTicksToNs(armGetSystemTick());
+    }
+
+    // Stress and timing run for the pool on the console itself (it needs the real kernel primitives), enabled from the INI
+    bool CheckTaskPool(std::string LogPath)
+    {
+        bool ok = true;
+        std::ofstream ofs(LogPath, std::ios::trunc);
+        ofs << "Workers: " << GetTaskPoolWorkerCount() << std::endl;
+        {
+            std::atomic<u32> count(0);
+            u64 start = GetNanoseconds();
+            TaskGroup grp;
+            for(u32 i = 0; i < 20000; i++) grp.Run([&count]()
+            {
+                count.fetch_add(1);
+            });
+            grp.Wait();
+            bool pass = (count.load() == 20000);
+            ok = (ok && pass);
+            ofs << "Flat group, 20000 tasks: " << (pass ? "ok" : "FAILED") << ", " << ((GetNanoseconds() - start) / 1000) << " us" << std::endl;
+        }
+        {
+            std::atomic<u32> count(0);
+            u64 start = GetNanoseconds();
+            TaskGroup grp;
+            for(u32 i = 0; i < 64; i++) grp.Run([&count]()
+            {
+                TaskGroup sub;
+                for(u32 j = 0; j < 64; j++) sub.Run([&count]()
+                {
+                    count.fetch_add(1);
+                });
+                sub.Wait();
+            });
+            grp.Wait();
+            bool pass = (count.load() == 4096);
+            ok = (ok && pass);
+            ofs << "Nested groups, 64x64 tasks: " << (pass ? "ok" : "FAILED") << ", " << ((GetNanoseconds() - start) / 1000) << " us" << std::endl;
+        }
+        {
+            std::atomic<u32> count(0);
+            TaskGroup grp;
+            ParallelFor(0, 8, 1, [&grp, &count](u64 Begin, u64 End)
+            {
+                for(u32 i = 0; i < 2000; i++) grp.Run([&count]()
+                {
+                    count.fetch_add(1);
+                });
+            });
+            grp.Wait();
+            bool pass = (count.load() == 16000);
+            ok = (ok && pass);
+            ofs << "Concurrent submitters, 8x2000 tasks: " << (pass ? "ok" : "FAILED") << std::endl;
+        }
+        {
+            std::atomic<u32> stages[16];
+            std::atomic<bool> order(true);
+            for(u32 i = 0; i < 16; i++) stages[i] = 0;
+            TaskGraph graph;
+            for(u32 i = 0; i < 16; i++) for(u32 j = 0; j < 8; j++)
+            {
+                u32 node = graph.Add([&stages, &order, i]()
+                {
+                    if((i > 0) && (stages[i - 1].load() != 8)) order = false;
+                    stages[i].fetch_add(1);
+                });
+                if(i > 0) for(u32 k = 0; k < 8; k++) graph.Depend(node, (((i - 1) * 8) + k));
+            }
+            graph.Run();
+            bool pass = (order.load() && (stages[15].load() == 8));
+            ok = (ok && pass);
+            ofs << "Task graph, 16 stages of 8: " << (pass ? "ok" : "FAILED") << std::endl;
+        }
+        {
+            u64 slice = 0x100000;
+            u64 slices = 64;
+            u8 *data = (u8*)malloc(slice * slices);
+            if(data != NULL)
+            {
+                for(u64 i = 0; i < (slice * slices); i++) data[i] = (u8)(i * 31);
+                std::vector<u8> shash(slices * 0x20);
+                std::vector<u8> phash(slices * 0x20);
+                u64 start = GetNanoseconds();
+                for(u64 i = 0; i < slices; i++) mbedtls_sha256_ret((data + (i * slice)), slice, &shash[i * 0x20], 0);
+                u64 serial = (GetNanoseconds() - start);
+                start = GetNanoseconds();
+                ParallelFor(0, slices, 1, [data, slice, &phash](u64 Begin, u64 End)
+                {
+                    for(u64 i = Begin; i < End; i++) mbedtls_sha256_ret((data + (i * slice)), slice, &phash[i * 0x20], 0);
+                });
+                u64 parallel = (GetNanoseconds() - start);
+                free(data);
+                bool pass = (memcmp(shash.data(), phash.data(), shash.size()) == 0);
+                ok = (ok && pass);
+                ofs << "SHA-256 of 64MB in 1MB slices: " << (pass ? "ok" : "FAILED") << ", serial " << (serial / 1000000) << " ms, parallel " << (parallel / 1000000) << " ms" << std::endl;
+            }
+            else ofs << "SHA-256 benchmark skipped: out of memory" << std::endl;
+        }
+        ofs << (ok ? "All checks passed" : "Some checks FAILED") << std::endl;
+        ofs.close();
+        return ok;
+    }
+}
\ No newline at end of file
@@ -1,11 +1,15 @@
 #include <gleaf/horizon/Title.hpp>
 #include <gleaf/horizon/NCAId.hpp>
 #include <gleaf/fs.hpp>
+#include <gleaf/err.hpp>
+#include <gleaf/horizon/Misc.hpp>
 #include <fstream>
 #include <sstream>
 #include <iomanip>
 #include <sys/stat.h>
 #include <dirent.h>
+#include <list>
+#include <map>
 
 namespace gleaf::horizon
 {
@@ -39,81 +43,143 @@ namespace gleaf::horizon
         return fs::FormatSize(this->GetTotalSize());
     }
 
-    NacpStruct *Title::TryGetNACP()
+    typedef std::pair<u64, u32> ControlDataKey;
+    typedef std::pair<ControlDataKey, std::shared_ptr<ControlData>> ControlDataEntry;
+
+    static std::list<ControlDataEntry> ctcache;
+    static std::map<ControlDataKey, std::list<ControlDataEntry>::iterator> ctcacheidx;
+    static u64 ctcachesize = 0;
+    static u64 ctcachebudget = 0x800000;
+    static Mutex ctcachelock;
+
+    static u64 ControlDataSize(const std::shared_ptr<ControlData> &Data)
     {
-        NacpStruct *nacp = NULL;
-        NsApplicationControlData *ctdata = (NsApplicationControlData*)malloc(sizeof(NsApplicationControlData));
-        size_t acsz = 0;
-        Result rc = nsGetApplicationControlData(1, this->ApplicationId, ctdata, sizeof(NsApplicationControlData), &acsz);
-        if((rc == 0) && !(acsz < sizeof(ctdata->nacp)))
-        {
-            nacp = (NacpStruct*)malloc(sizeof(NacpStruct));
-            memcpy(nacp, &ctdata->nacp, sizeof(NacpStruct));
-        }
-        else
+        return (sizeof(ControlData) + Data->Icon.size());
+    }
+
+    static void TrimControlDataCache()
+    {
+        while((ctcachesize > ctcachebudget) && !ctcache.empty())
         {
-            rc = nsGetApplicationControlData(1, GetBaseApplicationId(this->ApplicationId, this->Type), ctdata, sizeof(NsApplicationControlData), &acsz);
-            if((rc == 0) && !(acsz < sizeof(ctdata->nacp)))
-            {
-                nacp = (NacpStruct*)malloc(sizeof(NacpStruct));
-                memcpy(nacp, &ctdata->nacp, sizeof(NacpStruct));
-            }
+            ControlDataEntry &last = ctcache.back();
+            ctcachesize -= ControlDataSize(last.second);
+            ctcacheidx.erase(last.first);
+            ctcache.pop_back();
         }
-        free(ctdata);
-        ctdata = NULL;
-        return nacp;
     }
 
-    u8 *Title::TryGetIcon()
+    std::shared_ptr<ControlData> Title::GetControlData()
     {
-        u8 *icon = NULL;
+        ControlDataKey key = std::make_pair(this->ApplicationId, this->Version);
+        mutexLock(&ctcachelock);
+        auto it = ctcacheidx.find(key);
+        if(it != ctcacheidx.end())
+        {
+            ctcache.splice(ctcache.begin(), ctcache, it->second);
+            std::shared_ptr<ControlData> cdata = it->second->second;
+            mutexUnlock(&ctcachelock);
+            return cdata;
+        }
+        mutexUnlock(&ctcachelock);
         NsApplicationControlData *ctdata = (NsApplicationControlData*)malloc(sizeof(NsApplicationControlData));
+        if(ctdata == NULL) return NULL;
         size_t acsz = 0;
         Result rc = nsGetApplicationControlData(1, this->ApplicationId, ctdata, sizeof(NsApplicationControlData), &acsz);
-        if((rc == 0) && !(acsz < sizeof(ctdata->nacp)))
+        if((rc != 0) || (acsz < sizeof(ctdata->nacp))) rc = nsGetApplicationControlData(1, GetBaseApplicationId(this->ApplicationId, this->Type), ctdata, sizeof(NsApplicationControlData), &acsz);
+        if((rc != 0) || (acsz < sizeof(ctdata->nacp)))
         {
-            icon = (u8*)malloc(0x20000);
-            memcpy(icon, ctdata->icon, 0x20000);
+            free(ctdata);
+            return NULL;
         }
-        else
+        std::shared_ptr<ControlData> cdata = std::make_shared<ControlData>();
+        memcpy(&cdata->NACP, &ctdata->nacp, sizeof(NacpStruct));
+        cdata->Icon.assign(ctdata->icon, ctdata->icon + (acsz - sizeof(ctdata->nacp)));
+        free(ctdata);
+        mutexLock(&ctcachelock);
+        if(ctcacheidx.find(key) == ctcacheidx.end())
         {
-            rc = nsGetApplicationControlData(1, GetBaseApplicationId(this->ApplicationId, this->Type), ctdata, sizeof(NsApplicationControlData), &acsz);
-            if((rc == 0) && !(acsz < sizeof(ctdata->nacp)))
-            {
-                icon = (u8*)malloc(0x20000);
-                memcpy(icon, ctdata->icon, 0x20000);
-            }
+            ctcache.push_front(std::make_pair(key, cdata));
+            ctcacheidx[key] = ctcache.begin();
+            ctcachesize += ControlDataSize(cdata);
+            TrimControlDataCache();
         }
-        free(ctdata);
-        ctdata = NULL;
+        mutexUnlock(&ctcachelock);
+        return cdata;
+    }
+
+    NacpStruct *Title::TryGetNACP()
+    {
+        auto cdata = this->GetControlData();
+        if(cdata == NULL) return NULL;
+        NacpStruct *nacp = (NacpStruct*)malloc(sizeof(NacpStruct));
+        if(nacp == NULL) return NULL;
+        memcpy(nacp, &cdata->NACP, sizeof(NacpStruct));
+        return nacp;
+    }
+
+    u8 *Title::TryGetIcon()
+    {
+        auto cdata = this->GetControlData();
+        if((cdata == NULL) || cdata->Icon.empty()) return NULL;
+        u8 *icon = (u8*)malloc(0x20000);
+        if(icon == NULL) return NULL;
+        memset(icon, 0, 0x20000);
+        memcpy(icon, cdata->Icon.data(), std::min(cdata->Icon.size(), (size_t)0x20000));
         return icon;
     }
 
+    static bool ReadControlStamp(u64 ApplicationId, ControlCacheStamp *Out)
+    {
+        std::string fstamp = GetExportedControlStampPath(ApplicationId);
+        auto sdexp = fs::GetSdCardExplorer();
+        if(!sdexp->IsFile(fstamp)) return false;
+        if(sdexp->ReadFileBlock(fstamp, 0, sizeof(ControlCacheStamp), (u8*)Out) != sizeof(ControlCacheStamp)) return false;
+        return ((Out->Magic == ControlCacheMagic) && (Out->Format == ControlCacheFormat));
+    }
+
     bool Title::DumpControlData()
     {
-        bool hicon = false;
-        std::string fappid = FormatApplicationId(this->ApplicationId);
-        NacpStruct *nacp = this->TryGetNACP();
+        ControlCacheStamp stamp;
+        if(ReadControlStamp(this->ApplicationId, &stamp) && (stamp.Version == this->Version)) return (stamp.IconSize > 0);
+        auto cdata = this->GetControlData();
+        if(cdata == NULL) return false;
         auto sdexp = fs::GetSdCardExplorer();
-        if(nacp != NULL)
+        sdexp->WriteFileBlock(GetExportedNACPPath(this->ApplicationId), (u8*)&cdata->NACP, sizeof(NacpStruct));
+        stamp.Magic = ControlCacheMagic;
+        stamp.Format = ControlCacheFormat;
+        stamp.Version = this->Version;
+        stamp.IconSize = cdata->Icon.size();
+        if(stamp.IconSize > 0) sdexp->WriteFileBlock(GetExportedIconPath(this->ApplicationId), cdata->Icon.data(), stamp.IconSize);
+        sdexp->WriteFileBlock(GetExportedControlStampPath(this->ApplicationId), (u8*)&stamp, sizeof(ControlCacheStamp));
+        return (stamp.IconSize > 0);
+    }
+
+    bool Title::IsControlDataCached()
+    {
+        ControlCacheStamp stamp;
+        return (ReadControlStamp(this->ApplicationId, &stamp) && (stamp.Version == this->Version));
+    }
+
+    bool Title::HasCachedIcon()
+    {
+        ControlCacheStamp stamp;
+        return (ReadControlStamp(this->ApplicationId, &stamp) && (stamp.Version == this->Version) && (stamp.IconSize > 0));
+    }
+
+    NacpStruct *Title::TryGetCachedNACP(bool *HasIcon)
+    {
+        ControlCacheStamp stamp;
+        if(!ReadControlStamp(this->ApplicationId, &stamp) || (stamp.Version != this->Version)) return NULL;
+        NacpStruct *nacp = (NacpStruct*)malloc(sizeof(NacpStruct));
+        // Reported as not cached, so the caller takes the ns path instead
+        if(nacp == NULL) return NULL;
+        if(HasIcon != NULL) *HasIcon = (stamp.IconSize > 0);
+        if(fs::GetSdCardExplorer()->ReadFileBlock(GetExportedNACPPath(this->ApplicationId), 0, sizeof(NacpStruct), (u8*)nacp) != sizeof(NacpStruct))
         {
-            std::string fnacp = "goldleaf/title/" + fappid + ".nacp";
-            sdexp->DeleteFile(fnacp);
-            sdexp->WriteFileBlock(fnacp, (u8*)nacp, sizeof(NacpStruct));
             free(nacp);
             nacp = NULL;
         }
-        u8 *jpg = this->TryGetIcon();
-        if(jpg != NULL)
-        {
-            std::string fjpg = "goldleaf/title/" + fappid + ".jpg";
-            sdexp->DeleteFile(fjpg);
-            sdexp->WriteFileBlock(fjpg, jpg, 0x20000);
-            free(jpg);
-            jpg = NULL;
-            hicon = true;
-        }
-        return hicon;
+        return nacp;
     }
 
     TitleContents Title::GetContents()
@@ -317,6 +383,150 @@ namespace gleaf::horizon
         return rc;
     }
 
+    static Result MoveApplicationRecord(Title &ToMove, Storage Destination)
+    {
+        u64 baseappid = GetBaseApplicationId(ToMove.ApplicationId, ToMove.Type);
+        auto res1 = ns::CountApplicationContentMeta(baseappid);
+        u32 cmetacount = std::get<1>(res1);
+        // Contents without an application record (system titles) have nothing to rewrite
+        if((std::get<0>(res1) != 0) || (cmetacount == 0)) return 0;
+        std::vector<ns::ContentStorageRecord> recs(cmetacount);
+        size_t csbufs = (cmetacount * sizeof(ns::ContentStorageRecord));
+        auto res2 = ns::ListApplicationRecordContentMeta(0, baseappid, recs.data(), csbufs);
+        Result rc = std::get<0>(res2);
+        if(rc != 0) return rc;
+        std::vector<ns::ContentStorageRecord> orecs = recs;
+        for(auto &rec: recs) if((rec.Record.titleId == ToMove.Record.titleId) && (rec.Record.version == ToMove.Record.version) && (rec.Record.type == ToMove.Record.type)) rec.StorageId = static_cast<u64>(Destination);
+        rc = ns::DeleteApplicationRecord(baseappid);
+        if(rc != 0) return rc;
+        rc = ns::PushApplicationRecord(baseappid, 3, recs.data(), csbufs);
+        // The source contents are still there, so the old record keeps the title launchable
+        if(rc != 0) ns::PushApplicationRecord(baseappid, 3, orecs.data(), csbufs);
+        return rc;
+    }
+
+    Result MoveTitle(Title &ToMove, Storage Destination, Progress &Prog)
+    {
+        if(ToMove.Location == Destination) return 0;
+        if(ExistsTitle(ncm::ContentMetaType::Any, Destination, ToMove.ApplicationId)) return err::Make(err::ErrorDescription::TitleAlreadyInstalled);
+        auto cnts = ToMove.GetContents();
+        std::vector<ContentId> ids;
+        ContentId all[] = { cnts.Meta, cnts.Program, cnts.Data, cnts.Control, cnts.HtmlDocument, cnts.LegalInfo };
+        for(u32 i = 0; i < 6; i++) if(!all[i].Empty) ids.push_back(all[i]);
+        if(ids.empty()) return err::Make(err::ErrorDescription::CouldNotLocateTitleContents);
+        u64 fspace = ((Destination == Storage::SdCard) ? GetSdCardFreeSpaceForInstalls() : GetNANDFreeSpaceForInstalls());
+        if(fspace < cnts.GetTotalSize()) return err::Make(err::ErrorDescription::NotEnoughSize);
+        NcmContentStorage srccst;
+        NcmContentStorage dstcst;
+        Result rc = ncmOpenContentStorage(static_cast<FsStorageId>(ToMove.Location), &srccst);
+        if(rc != 0) return rc;
+        rc = ncmOpenContentStorage(static_cast<FsStorageId>(Destination), &dstcst);
+        if(rc != 0)
+        {
+            serviceClose(&srccst.s);
+            return rc;
+        }
+        u64 rmax = fs::GetFileSystemOperationsBufferSize();
+        u8 *data = fs::GetFileSystemOperationsBuffer();
+        Prog.SetTotal(cnts.GetTotalSize(), ids.size());
+        std::vector<NcmNcaId> written;
+        for(u32 i = 0; i < ids.size(); i++)
+        {
+            NcmNcaId curid = ids[i].NCAId;
+            bool has = false;
+            ncmContentStorageHas(&dstcst, &curid, &has);
+            if(has)
+            {
+                Prog.Advance(ids[i].Size);
+                Prog.CompleteItem();
+                continue;
+            }
+            ncm::DeletePlaceHolder(&dstcst, &curid);
+            rc = ncm::CreatePlaceHolder(&dstcst, &curid, &curid, ids[i].Size);
+            if(rc != 0) break;
+            u64 off = 0;
+            while(off < ids[i].Size)
+            {
+                if(!Prog.CheckPoint())
+                {
+                    rc = err::Make(err::ErrorDescription::OperationCancelled);
+                    break;
+                }
+                u64 rsize = std::min(rmax, (ids[i].Size - off));
+                rc = ncmContentStorageReadContentIdFile(&srccst, &curid, off, data, rsize);
+                if(rc != 0) break;
+                rc = ncm::WritePlaceHolder(&dstcst, &curid, off, data, rsize);
+                if(rc != 0) break;
+                off += rsize;
+                Prog.Advance(rsize);
+            }
+            if(rc == 0) rc = ncmContentStorageRegister(&dstcst, &curid, &curid);
+            ncm::DeletePlaceHolder(&dstcst, &curid);
+            if(rc != 0) break;
+            written.push_back(curid);
+            Prog.CompleteItem();
+        }
+        bool dstmeta = false;
+        if(rc == 0)
+        {
+            NcmContentMetaDatabase srcmdb;
+            NcmContentMetaDatabase dstmdb;
+            rc = ncmOpenContentMetaDatabase(static_cast<FsStorageId>(ToMove.Location), &srcmdb);
+            if(rc == 0)
+            {
+                auto res = ncm::ContentMetaDatabase::GetSize(&srcmdb, &ToMove.Record);
+                rc = std::get<0>(res);
+                u64 msize = std::get<1>(res);
+                if(rc == 0)
+                {
+                    std::vector<u8> mdata(msize);
+                    u64 mread = 0;
+                    rc = ncmContentMetaDatabaseGet(&srcmdb, &ToMove.Record, msize, (NcmContentMetaRecordsHeader*)mdata.data(), &mread);
+                    if(rc == 0) rc = ncmOpenContentMetaDatabase(static_cast<FsStorageId>(Destination), &dstmdb);
+                    if(rc == 0)
+                    {
+                        rc = ncmContentMetaDatabaseSet(&dstmdb, &ToMove.Record, mread, (NcmContentMetaRecordsHeader*)mdata.data());
+                        if(rc == 0) rc = ncmContentMetaDatabaseCommit(&dstmdb);
+                        dstmeta = (rc == 0);
+                        serviceClose(&dstmdb.s);
+                    }
+                }
+                serviceClose(&srcmdb.s);
+            }
+        }
+        if(rc == 0) rc = MoveApplicationRecord(ToMove, Destination);
+        if(rc != 0)
+        {
+            // Undo everything on the destination side; the source is untouched until this point
+            if(dstmeta)
+            {
+                NcmContentMetaDatabase dstmdb;
+                if(ncmOpenContentMetaDatabase(static_cast<FsStorageId>(Destination), &dstmdb) == 0)
+                {
+                    if(ncmContentMetaDatabaseRemove(&dstmdb, &ToMove.Record) == 0) ncmContentMetaDatabaseCommit(&dstmdb);
+                    serviceClose(&dstmdb.s);
+                }
+            }
+            for(u32 i = 0; i < written.size(); i++) ncmContentStorageDelete(&dstcst, &written[i]);
+            serviceClose(&dstcst.s);
+            serviceClose(&srccst.s);
+            return rc;
+        }
+        for(u32 i = 0; i < ids.size(); i++) ncmContentStorageDelete(&srccst, &ids[i].NCAId);
+        serviceClose(&dstcst.s);
+        serviceClose(&srccst.s);
+        NcmContentMetaDatabase metadb;
+        rc = ncmOpenContentMetaDatabase(static_cast<FsStorageId>(ToMove.Location), &metadb);
+        if(rc == 0)
+        {
+            rc = ncmContentMetaDatabaseRemove(&metadb, &ToMove.Record);
+            if(rc == 0) ncmContentMetaDatabaseCommit(&metadb);
+        }
+        serviceClose(&metadb.s);
+        ToMove.Location = Destination;
+        return rc;
+    }
+
     std::vector<Ticket> GetAllTickets()
     {
         std::vector<Ticket> tickets;
@@ -351,6 +561,36 @@ namespace gleaf::horizon
         return "sdmc:/goldleaf/title/" + FormatApplicationId(ApplicationId) + ".nacp";
     }
 
+    std::string GetExportedControlStampPath(u64 ApplicationId)
+    {
+        return "sdmc:/goldleaf/title/" + FormatApplicationId(ApplicationId) + ".stamp";
+    }
+
+    void SetControlDataCacheBudget(u64 Bytes)
+    {
+        mutexLock(&ctcachelock);
+        ctcachebudget = Bytes;
+        TrimControlDataCache();
+        mutexUnlock(&ctcachelock);
+    }
+
+    u64 GetControlDataCacheSize()
+    {
+        mutexLock(&ctcachelock);
+        u64 sz = ctcachesize;
+        mutexUnlock(&ctcachelock);
+        return sz;
+    }
+
+    void ClearControlDataCache()
+    {
+        mutexLock(&ctcachelock);
+        ctcache.clear();
+        ctcacheidx.clear();
+        ctcachesize = 0;
+        mutexUnlock(&ctcachelock);
+    }
+
     u64 GetBaseApplicationId(u64 ApplicationId, ncm::ContentMetaType Type)
     {
         u64 appid = ApplicationId;
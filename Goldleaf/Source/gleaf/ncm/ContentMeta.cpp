@@ -46,6 +46,15 @@ namespace gleaf::ncm
         return contentRecords;
     }
 
+    std::vector<HashedContentRecord> ContentMeta::GetHashedContentRecords()
+    {
+        ContentMetaHeader contentMetaHeader = this->GetContentMetaHeader();
+        std::vector<HashedContentRecord> hashedContentRecords;
+        HashedContentRecord *records = (HashedContentRecord*)(buf.GetData() + sizeof(ContentMetaHeader) + contentMetaHeader.ExtendedHeaderSize);
+        for(u32 i = 0; i < contentMetaHeader.ContentCount; i++) hashedContentRecords.push_back(records[i]);
+        return hashedContentRecords;
+    }
+
     void ContentMeta::GetInstallContentMeta(ByteBuffer &CNMTBuffer, ContentRecord &CNMTRecord, bool IgnoreVersion)
     {
         ContentMetaHeader contentMetaHeader = this->GetContentMetaHeader();
@@ -0,0 +1,535 @@
+#include <gleaf/net/Download.hpp>
+#include <gleaf/net/Session.hpp>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+namespace gleaf::net
+{
+    static const u32 DownloadRetries = 5;
+    static const u64 MinSegmentSize = 0x100000;
+    static const u64 MinRangePartSize = 0x40000;
+    static const u64 StateSaveIntervalMs = 1000;
+
+    struct DownloadProbe
+    {
+        std::string URL;
+        u64 Size;
+        bool Ranges;
+        std::string ETag;
+        std::string LastModified;
+    };
+
+    struct SegmentTransfer
+    {
+        DownloadSegment *Segment;
+        FILE *File;
+        CURL *Curl;
+        curl_slist *Headers;
+        u32 Retries;
+        u64 StartDone;
+        bool Checked;
+        bool RangeOk;
+    };
+
+    struct RangePart
+    {
+        u8 *Out;
+        u64 Offset;
+        u64 Size;
+        u64 Done;
+        CURL *Curl;
+        u32 Retries;
+        u64 StartDone;
+        bool Checked;
+        bool RangeOk;
+    };
+
+    static CURL *AcquireDownloadHandle(std::string URL)
+    {
+        CURL *Curl = AcquireHandle(URL);
+        if(Curl == NULL) return NULL;
+        curl_easy_setopt(Curl, CURLOPT_FAILONERROR, 1L);
+        // Stalled connections (flaky Wi-Fi) fail and get retried instead of hanging forever
+        curl_easy_setopt(Curl, CURLOPT_LOW_SPEED_LIMIT, 1L);
+        curl_easy_setopt(Curl, CURLOPT_LOW_SPEED_TIME, 20L);
+        return Curl;
+    }
+
+    static size_t ProbeHeader(char *Buffer, size_t Size, size_t Count, void *Data)
+    {
+        DownloadProbe *probe = (DownloadProbe*)Data;
+        size_t total = (Size * Count);
+        std::string value(Buffer, total);
+        std::string line = value;
+        std::transform(line.begin(), line.end(), line.begin(), ::tolower);
+        size_t colon = value.find(':');
+        if(colon != std::string::npos)
+        {
+            value = value.substr(colon + 1);
+            value.erase(0, value.find_first_not_of(" \t"));
+            value.erase(value.find_last_not_of(" \t\r\n") + 1);
+        }
+        // Every redirect reports its own headers, only the last response counts
+        if(line.substr(0, 5) == "http/")
+        {
+            probe->Ranges = false;
+            probe->ETag = "";
+            probe->LastModified = "";
+        }
+        else if((line.substr(0, 14) == "accept-ranges:") && (line.find("bytes") != std::string::npos)) probe->Ranges = true;
+        else if(line.substr(0, 5) == "etag:") probe->ETag = value;
+        else if(line.substr(0, 14) == "last-modified:") probe->LastModified = value;
+        return total;
+    }
+
+    // If-Range only takes a strong ETag or a date; without either a changed file can't be told apart from the partial one
+    static std::string GetValidator(DownloadProbe &Probe)
+    {
+        if(!Probe.ETag.empty() && (Probe.ETag.substr(0, 2) != "W/")) return Probe.ETag;
+        return Probe.LastModified;
+    }
+
+    static bool ProbeDownload(std::string URL, DownloadProbe &Probe)
+    {
+        Probe.URL = URL;
+        Probe.Size = 0;
+        Probe.Ranges = false;
+        Probe.ETag = "";
+        Probe.LastModified = "";
+        CURL *curl = AcquireDownloadHandle(URL);
+        if(curl == NULL) return false;
+        curl_easy_setopt(curl, CURLOPT_NOBODY, 1L);
+        curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, ProbeHeader);
+        curl_easy_setopt(curl, CURLOPT_HEADERDATA, &Probe);
+        CURLcode rc = curl_easy_perform(curl);
+        if(rc == CURLE_OK)
+        {
+            curl_off_t len = -1;
+            curl_easy_getinfo(curl, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &len);
+            if(len > 0) Probe.Size = (u64)len;
+            char *eurl = NULL;
+            curl_easy_getinfo(curl, CURLINFO_EFFECTIVE_URL, &eurl);
+            if(eurl != NULL) Probe.URL = std::string(eurl);
+        }
+        ReleaseHandle(curl);
+        return (rc == CURLE_OK);
+    }
+
+    static size_t SingleWrite(char *In, size_t Size, size_t Count, void *Data)
+    {
+        return fwrite(In, 1, (Size * Count), (FILE*)Data);
+    }
+
+    static int SingleProgress(void *Data, curl_off_t TotalToDownload, curl_off_t NowDownloaded, curl_off_t TotalToUpload, curl_off_t NowUploaded)
+    {
+        Progress *prog = (Progress*)Data;
+        if((TotalToDownload > 0) && (prog->GetBytesTotal() != (u64)TotalToDownload)) prog->SetTotal(TotalToDownload, 1);
+        prog->SetDone(NowDownloaded);
+        return (prog->CheckPoint() ? 0 : 1);
+    }
+
+    // Servers without range support: a plain stream, which cannot be resumed
+    static Result DownloadSingle(std::string URL, std::string Path, Progress &Prog)
+    {
+        FILE *f = fopen(Path.c_str(), "wb");
+        if(!f) return err::MakeErrno(errno);
+        CURL *curl = AcquireDownloadHandle(URL);
+        CURLcode rc = CURLE_FAILED_INIT;
+        if(curl != NULL)
+        {
+            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, SingleWrite);
+            curl_easy_setopt(curl, CURLOPT_WRITEDATA, f);
+            curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+            curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, SingleProgress);
+            curl_easy_setopt(curl, CURLOPT_XFERINFODATA, &Prog);
+            rc = curl_easy_perform(curl);
+            ReleaseHandle(curl);
+        }
+        fclose(f);
+        if(Prog.IsCancelled())
+        {
+            remove(Path.c_str());
+            return err::Make(err::ErrorDescription::OperationCancelled);
+        }
+        if(rc != CURLE_OK) return err::Make(err::ErrorDescription::DownloadFailed);
+        Prog.SetDone(Prog.GetBytesTotal());
+        return 0;
+    }
+
+    static bool ReadStateString(FILE *File, std::string &Out)
+    {
+        u32 len = 0;
+        if(fread(&len, 1, sizeof(u32), File) != sizeof(u32)) return false;
+        if(len > 0x10000) return false;
+        Out = std::string(len, '\0');
+        return (fread(&Out[0], 1, len, File) == len);
+    }
+
+    static void WriteStateString(FILE *File, std::string Str)
+    {
+        u32 len = Str.length();
+        fwrite(&len, 1, sizeof(u32), File);
+        fwrite(Str.c_str(), 1, len, File);
+    }
+
+    static bool LoadDownloadState(std::string StatePath, std::string URL, u64 Size, std::string Validator, std::vector<DownloadSegment> &Segments)
+    {
+        FILE *f = fopen(StatePath.c_str(), "rb");
+        if(!f) return false;
+        bool ok = false;
+        char magic[4];
+        u64 ssize = 0;
+        std::string surl;
+        std::string svalid;
+        if((fread(magic, 1, 4, f) == 4) && (memcmp(magic, "GLD2", 4) == 0) && (fread(&ssize, 1, sizeof(u64), f) == sizeof(u64)) && (ssize == Size) && ReadStateString(f, surl) && (surl == URL) && ReadStateString(f, svalid) && (svalid == Validator))
+        {
+            u32 count = 0;
+            if((fread(&count, 1, sizeof(u32), f) == sizeof(u32)) && (count > 0) && (count <= 64))
+            {
+                Segments.resize(count);
+                ok = (fread(Segments.data(), sizeof(DownloadSegment), count, f) == count);
+                for(u32 i = 0; ok && (i < count); i++) if(Segments[i].Done > Segments[i].Size) ok = false;
+            }
+        }
+        fclose(f);
+        return ok;
+    }
+
+    static void SaveDownloadState(std::string StatePath, std::string URL, u64 Size, std::string Validator, std::vector<DownloadSegment> &Segments)
+    {
+        FILE *f = fopen(StatePath.c_str(), "wb");
+        if(!f) return;
+        u32 count = Segments.size();
+        fwrite("GLD2", 1, 4, f);
+        fwrite(&Size, 1, sizeof(u64), f);
+        WriteStateString(f, URL);
+        WriteStateString(f, Validator);
+        fwrite(&count, 1, sizeof(u32), f);
+        fwrite(Segments.data(), sizeof(DownloadSegment), count, f);
+        fclose(f);
+    }
+
+    static size_t SegmentWrite(char *In, size_t Size, size_t Count, void *Data)
+    {
+        SegmentTransfer *xfer = (SegmentTransfer*)Data;
+        size_t total = (Size * Count);
+        if(!xfer->Checked)
+        {
+            // A 200 means no range support or, through If-Range, a file changed since the probe: either way this offset would get the file's start
+            long code = 0;
+            curl_easy_getinfo(xfer->Curl, CURLINFO_RESPONSE_CODE, &code);
+            xfer->Checked = true;
+            xfer->RangeOk = (code == 206);
+            if(!xfer->RangeOk) return 0;
+        }
+        u64 left = (xfer->Segment->Size - xfer->Segment->Done);
+        size_t wsize = std::min((u64)total, left);
+        if(fwrite(In, 1, wsize, xfer->File) != wsize) return 0;
+        xfer->Segment->Done += wsize;
+        return total;
+    }
+
+    static bool StartSegment(CURLM *Multi, SegmentTransfer &Transfer, std::string URL, std::string Path, std::string Validator)
+    {
+        DownloadSegment *seg = Transfer.Segment;
+        Transfer.File = fopen(Path.c_str(), "r+b");
+        if(!Transfer.File) return false;
+        fseek(Transfer.File, (seg->Offset + seg->Done), SEEK_SET);
+        Transfer.Curl = AcquireDownloadHandle(URL);
+        if(Transfer.Curl == NULL)
+        {
+            fclose(Transfer.File);
+            Transfer.File = NULL;
+            return false;
+        }
+        Transfer.StartDone = seg->Done;
+        Transfer.Checked = false;
+        Transfer.RangeOk = true;
+        std::string range = std::to_string(seg->Offset + seg->Done) + "-" + std::to_string(seg->Offset + seg->Size - 1);
+        curl_easy_setopt(Transfer.Curl, CURLOPT_RANGE, range.c_str());
+        if(!Validator.empty())
+        {
+            Transfer.Headers = curl_slist_append(NULL, ("If-Range: " + Validator).c_str());
+            curl_easy_setopt(Transfer.Curl, CURLOPT_HTTPHEADER, Transfer.Headers);
+        }
+        curl_easy_setopt(Transfer.Curl, CURLOPT_WRITEFUNCTION, SegmentWrite);
+        curl_easy_setopt(Transfer.Curl, CURLOPT_WRITEDATA, &Transfer);
+        curl_easy_setopt(Transfer.Curl, CURLOPT_PRIVATE, &Transfer);
+        curl_multi_add_handle(Multi, Transfer.Curl);
+        return true;
+    }
+
+    static void StopSegment(CURLM *Multi, SegmentTransfer &Transfer)
+    {
+        if(Transfer.Curl != NULL)
+        {
+            curl_multi_remove_handle(Multi, Transfer.Curl);
+            ReleaseHandle(Transfer.Curl);
+            Transfer.Curl = NULL;
+        }
+        if(Transfer.Headers != NULL)
+        {
+            curl_slist_free_all(Transfer.Headers);
+            Transfer.Headers = NULL;
+        }
+        if(Transfer.File != NULL)
+        {
+            fclose(Transfer.File);
+            Transfer.File = NULL;
+        }
+    }
+
+    static size_t RangeWrite(char *In, size_t Size, size_t Count, void *Data)
+    {
+        RangePart *part = (RangePart*)Data;
+        size_t total = (Size * Count);
+        if(!part->Checked)
+        {
+            long code = 0;
+            curl_easy_getinfo(part->Curl, CURLINFO_RESPONSE_CODE, &code);
+            part->Checked = true;
+            part->RangeOk = (code == 206);
+            if(!part->RangeOk) return 0;
+        }
+        u64 left = (part->Size - part->Done);
+        size_t wsize = std::min((u64)total, left);
+        memcpy(part->Out + part->Done, In, wsize);
+        part->Done += wsize;
+        return total;
+    }
+
+    static bool StartRangePart(CURLM *Multi, RangePart &Part, std::string URL)
+    {
+        Part.Curl = AcquireDownloadHandle(URL);
+        if(Part.Curl == NULL) return false;
+        Part.StartDone = Part.Done;
+        Part.Checked = false;
+        Part.RangeOk = true;
+        std::string range = std::to_string(Part.Offset + Part.Done) + "-" + std::to_string(Part.Offset + Part.Size - 1);
+        curl_easy_setopt(Part.Curl, CURLOPT_RANGE, range.c_str());
+        curl_easy_setopt(Part.Curl, CURLOPT_WRITEFUNCTION, RangeWrite);
+        curl_easy_setopt(Part.Curl, CURLOPT_WRITEDATA, &Part);
+        curl_easy_setopt(Part.Curl, CURLOPT_PRIVATE, &Part);
+        curl_multi_add_handle(Multi, Part.Curl);
+        return true;
+    }
+
+    static void StopRangePart(CURLM *Multi, RangePart &Part)
+    {
+        if(Part.Curl == NULL) return;
+        curl_multi_remove_handle(Multi, Part.Curl);
+        ReleaseHandle(Part.Curl);
+        Part.Curl = NULL;
+    }
+
+    static u64 GetDownloadedSize(std::vector<DownloadSegment> &Segments)
+    {
+        u64 done = 0;
+        for(auto &seg: Segments) done += seg.Done;
+        return done;
+    }
+
+    static u64 GetFileSizeOf(std::string Path)
+    {
+        struct stat st;
+        if(stat(Path.c_str(), &st) != 0) return 0;
+        return st.st_size;
+    }
+
+    std::string GetDownloadStatePath(std::string Path)
+    {
+        return (Path + ".part");
+    }
+
+    Result DownloadFile(std::string URL, std::string Path, Progress &Prog, u32 Segments)
+    {
+        DownloadProbe probe;
+        if(!ProbeDownload(URL, probe)) return err::Make(err::ErrorDescription::DownloadFailed);
+        std::string spath = GetDownloadStatePath(Path);
+        if(!probe.Ranges || (probe.Size == 0))
+        {
+            remove(spath.c_str());
+            return DownloadSingle(probe.URL, Path, Prog);
+        }
+        // Resume data is matched against the requested URL, the redirected one may be signed and expire
+        std::string valid = GetValidator(probe);
+        std::vector<DownloadSegment> segs;
+        bool resume = (!valid.empty() && LoadDownloadState(spath, URL, probe.Size, valid, segs) && (GetFileSizeOf(Path) == probe.Size));
+        if(!resume)
+        {
+            FILE *f = fopen(Path.c_str(), "wb");
+            if(!f) return err::MakeErrno(errno);
+            int trc = ftruncate(fileno(f), probe.Size);
+            int terr = errno;
+            fclose(f);
+            if(trc != 0)
+            {
+                remove(Path.c_str());
+                return err::MakeErrno(terr);
+            }
+            u32 count = std::max((u64)1, std::min((u64)std::max(Segments, (u32)1), (probe.Size / MinSegmentSize)));
+            u64 segsize = (probe.Size / count);
+            segs.clear();
+            for(u32 i = 0; i < count; i++)
+            {
+                DownloadSegment seg;
+                seg.Offset = (i * segsize);
+                seg.Size = ((i == (count - 1)) ? (probe.Size - seg.Offset) : segsize);
+                seg.Done = 0;
+                segs.push_back(seg);
+            }
+            SaveDownloadState(spath, URL, probe.Size, valid, segs);
+        }
+        Prog.SetTotal(probe.Size, 1);
+        Prog.SetDone(GetDownloadedSize(segs));
+        CURLM *multi = curl_multi_init();
+        std::vector<SegmentTransfer> xfers(segs.size());
+        u32 active = 0;
+        bool failed = false;
+        bool norange = false;
+        for(u32 i = 0; i < segs.size(); i++)
+        {
+            xfers[i].Segment = &segs[i];
+            xfers[i].File = NULL;
+            xfers[i].Curl = NULL;
+            xfers[i].Headers = NULL;
+            xfers[i].Retries = 0;
+            if(segs[i].Done >= segs[i].Size) continue;
+            if(StartSegment(multi, xfers[i], probe.URL, Path, valid)) active++;
+            else failed = true;
+        }
+        auto lastsave = std::chrono::steady_clock::now();
+        while((active > 0) && !failed && !norange)
+        {
+            if(!Prog.CheckPoint()) break;
+            int running = 0;
+            curl_multi_perform(multi, &running);
+            int left = 0;
+            CURLMsg *msg = NULL;
+            while((msg = curl_multi_info_read(multi, &left)) != NULL)
+            {
+                if(msg->msg != CURLMSG_DONE) continue;
+                SegmentTransfer *xfer = NULL;
+                curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, (char**)&xfer);
+                if(xfer == NULL) continue;
+                StopSegment(multi, *xfer);
+                active--;
+                if(xfer->Segment->Done >= xfer->Segment->Size) continue;
+                // Retries only run out on consecutive attempts that got nothing
+                if(xfer->Segment->Done > xfer->StartDone) xfer->Retries = 0;
+                if(!xfer->RangeOk) norange = true;
+                else if(xfer->Retries < DownloadRetries)
+                {
+                    xfer->Retries++;
+                    if(StartSegment(multi, *xfer, probe.URL, Path, valid)) active++;
+                    else failed = true;
+                }
+                else failed = true;
+            }
+            Prog.SetDone(GetDownloadedSize(segs));
+            auto now = std::chrono::steady_clock::now();
+            if(std::chrono::duration_cast<std::chrono::milliseconds>(now - lastsave).count() >= (s64)StateSaveIntervalMs)
+            {
+                // Only what already reached the file may be recorded as done
+                for(auto &xfer: xfers) if(xfer.File != NULL) fflush(xfer.File);
+                SaveDownloadState(spath, URL, probe.Size, valid, segs);
+                lastsave = now;
+            }
+            if(active > 0) curl_multi_wait(multi, NULL, 0, 100, NULL);
+        }
+        for(auto &xfer: xfers) StopSegment(multi, xfer);
+        curl_multi_cleanup(multi);
+        Prog.SetDone(GetDownloadedSize(segs));
+        if(Prog.IsCancelled())
+        {
+            remove(Path.c_str());
+            remove(spath.c_str());
+            return err::Make(err::ErrorDescription::OperationCancelled);
+        }
+        if(norange)
+        {
+            remove(spath.c_str());
+            return DownloadSingle(probe.URL, Path, Prog);
+        }
+        if(GetDownloadedSize(segs) < probe.Size)
+        {
+            SaveDownloadState(spath, URL, probe.Size, valid, segs);
+            return err::Make(err::ErrorDescription::DownloadFailed);
+        }
+        remove(spath.c_str());
+        return 0;
+    }
+
+    u64 RetrieveRange(std::string URL, u64 Offset, u64 Size, u8 *Out, u32 Connections, std::atomic<bool> *Cancel)
+    {
+        if(Size == 0) return 0;
+        u32 count = std::max((u64)1, std::min((u64)std::max(Connections, (u32)1), (Size / MinRangePartSize)));
+        u64 partsize = (Size / count);
+        std::vector<RangePart> parts(count);
+        CURLM *multi = curl_multi_init();
+        u32 active = 0;
+        bool failed = false;
+        for(u32 i = 0; i < count; i++)
+        {
+            RangePart &part = parts[i];
+            part.Offset = (Offset + (i * partsize));
+            part.Size = ((i == (count - 1)) ? (Size - (i * partsize)) : partsize);
+            part.Out = (Out + (i * partsize));
+            part.Done = 0;
+            part.Curl = NULL;
+            part.Retries = 0;
+            if(StartRangePart(multi, part, URL)) active++;
+            else failed = true;
+        }
+        while((active > 0) && !failed)
+        {
+            if((Cancel != NULL) && Cancel->load()) break;
+            int running = 0;
+            curl_multi_perform(multi, &running);
+            int left = 0;
+            CURLMsg *msg = NULL;
+            while((msg = curl_multi_info_read(multi, &left)) != NULL)
+            {
+                if(msg->msg != CURLMSG_DONE) continue;
+                RangePart *part = NULL;
+                curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, (char**)&part);
+                if(part == NULL) continue;
+                StopRangePart(multi, *part);
+                active--;
+                if(part->Done >= part->Size) continue;
+                if(part->Done > part->StartDone) part->Retries = 0;
+                if(part->RangeOk && (part->Retries < DownloadRetries))
+                {
+                    part->Retries++;
+                    if(StartRangePart(multi, *part, URL)) active++;
+                    else failed = true;
+                }
+                else failed = true;
+            }
+            if(active > 0) curl_multi_wait(multi, NULL, 0, 100, NULL);
+        }
+        for(auto &part: parts) StopRangePart(multi, part);
+        curl_multi_cleanup(multi);
+        u64 done = 0;
+        for(auto &part: parts)
+        {
+            done += part.Done;
+            if(part.Done < part.Size) break;
+        }
+        return done;
+    }
+
+    bool RetrieveFileSize(std::string URL, u64 &Size, bool &Ranges)
+    {
+        DownloadProbe probe;
+        if(!ProbeDownload(URL, probe)) return false;
+        Size = probe.Size;
+        Ranges = probe.Ranges;
+        return true;
+    }
+}
\ No newline at end of file
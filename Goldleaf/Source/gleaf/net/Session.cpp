@@ -0,0 +1,108 @@
+#include <gleaf/net/Session.hpp>
+#include <vector>
+
+namespace gleaf::net
+{
+    static const u32 MaxIdleHandles = 4;
+
+    static Mutex sesslock;
+    static Mutex sharelocks[CURL_LOCK_DATA_LAST];
+    static bool sessopen = false;
+    static CURLSH *sessshare = NULL;
+    static std::vector<CURL*> sessidle;
+    static u32 sessbusy = 0;
+
+    static void SessionShareLock(CURL *Handle, curl_lock_data Data, curl_lock_access Access, void *User)
+    {
+        mutexLock(&sharelocks[Data]);
+    }
+
+    static void SessionShareUnlock(CURL *Handle, curl_lock_data Data, void *User)
+    {
+        mutexUnlock(&sharelocks[Data]);
+    }
+
+    void OpenSession()
+    {
+        mutexLock(&sesslock);
+        if(!sessopen)
+        {
+            socketInitializeDefault();
+            curl_global_init(CURL_GLOBAL_DEFAULT);
+            sessshare = curl_share_init();
+            if(sessshare != NULL)
+            {
+                curl_share_setopt(sessshare, CURLSHOPT_LOCKFUNC, SessionShareLock);
+                curl_share_setopt(sessshare, CURLSHOPT_UNLOCKFUNC, SessionShareUnlock);
+                curl_share_setopt(sessshare, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+                curl_share_setopt(sessshare, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+                curl_share_setopt(sessshare, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+            }
+            sessopen = true;
+        }
+        mutexUnlock(&sesslock);
+    }
+
+    void CloseSession()
+    {
+        mutexLock(&sesslock);
+        // A request still running (the update check has no way to be stopped) keeps everything alive until exit
+        if(sessopen && (sessbusy == 0))
+        {
+            for(auto &curl: sessidle) curl_easy_cleanup(curl);
+            sessidle.clear();
+            if(sessshare != NULL) curl_share_cleanup(sessshare);
+            sessshare = NULL;
+            curl_global_cleanup();
+            socketExit();
+            sessopen = false;
+        }
+        mutexUnlock(&sesslock);
+    }
+
+    bool IsSessionOpen()
+    {
+        mutexLock(&sesslock);
+        bool open = sessopen;
+        mutexUnlock(&sesslock);
+        return open;
+    }
+
+    CURL *AcquireHandle(std::string URL)
+    {
+        OpenSession();
+        mutexLock(&sesslock);
+        CURL *curl = NULL;
+        if(!sessidle.empty())
+        {
+            curl = sessidle.back();
+            sessidle.pop_back();
+        }
+        else curl = curl_easy_init();
+        if(curl != NULL) sessbusy++;
+        CURLSH *share = sessshare;
+        mutexUnlock(&sesslock);
+        if(curl == NULL) return NULL;
+        if(share != NULL) curl_easy_setopt(curl, CURLOPT_SHARE, share);
+        curl_easy_setopt(curl, CURLOPT_URL, URL.c_str());
+        curl_easy_setopt(curl, CURLOPT_USERAGENT, "Goldleaf");
+        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
+        curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
+        curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+        curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+        return curl;
+    }
+
+    void ReleaseHandle(CURL *Handle)
+    {
+        if(Handle == NULL) return;
+        // Resetting drops the options but keeps the handle's caches and live connections
+        curl_easy_reset(Handle);
+        mutexLock(&sesslock);
+        if(sessbusy > 0) sessbusy--;
+        bool keep = (sessidle.size() < MaxIdleHandles);
+        if(keep) sessidle.push_back(Handle);
+        mutexUnlock(&sesslock);
+        if(!keep) curl_easy_cleanup(Handle);
+    }
+}
\ No newline at end of file
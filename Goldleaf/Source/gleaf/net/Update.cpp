@@ -0,0 +1,264 @@
+#include <gleaf/net/Update.hpp>
+#include <gleaf/net/Network.hpp>
+#include <gleaf/net/Session.hpp>
+#include <gleaf/horizon/Misc.hpp>
+#include <algorithm>
+#include <fstream>
+#include <cstdio>
+#include <ctime>
+
+namespace gleaf::net
+{
+    static std::string updendpoint = "https://api.github.com/repos/xortroll/goldleaf/releases";
+    static UpdateCheckState updstate = UpdateCheckState::Idle;
+    static UpdateCheckResult updresult;
+    static bool updpending = false;
+    static bool updcancel = false;
+    static horizon::Thread *updthread = NULL;
+    static Mutex updlock;
+
+    static std::string GetReleasesCachePath()
+    {
+        return "sdmc:/goldleaf/releases.json";
+    }
+
+    static std::string GetReleasesMetaPath()
+    {
+        return "sdmc:/goldleaf/releases.meta";
+    }
+
+    static bool ReadReleasesCache(std::string Endpoint, std::string &JSON, std::string &ETag, u64 &Stamp)
+    {
+        std::ifstream meta(GetReleasesMetaPath());
+        if(!meta.good()) return false;
+        std::string ep;
+        std::string stamp;
+        std::getline(meta, ep);
+        std::getline(meta, stamp);
+        std::getline(meta, ETag);
+        meta.close();
+        if(ep != Endpoint) return false;
+        std::ifstream cache(GetReleasesCachePath(), std::ios::binary);
+        if(!cache.good()) return false;
+        JSON.assign(std::istreambuf_iterator<char>(cache), std::istreambuf_iterator<char>());
+        cache.close();
+        Stamp = strtoull(stamp.c_str(), NULL, 10);
+        return !JSON.empty();
+    }
+
+    // Both files are written aside and swapped in; the meta goes last, so a cut write leaves no cache rather than a torn one
+    static void WriteReleasesCache(std::string Endpoint, std::string JSON, std::string ETag, u64 Stamp)
+    {
+        std::string tcache = GetReleasesCachePath() + ".tmp";
+        std::string tmeta = GetReleasesMetaPath() + ".tmp";
+        std::ofstream cache(tcache, std::ios::binary | std::ios::trunc);
+        if(!cache.good()) return;
+        cache << JSON;
+        cache.close();
+        std::ofstream meta(tmeta, std::ios::trunc);
+        meta << Endpoint << "\n" << Stamp << "\n" << ETag << "\n";
+        meta.close();
+        if(cache.fail() || meta.fail())
+        {
+            remove(tcache.c_str());
+            remove(tmeta.c_str());
+            return;
+        }
+        remove(GetReleasesMetaPath().c_str());
+        remove(GetReleasesCachePath().c_str());
+        if(rename(tcache.c_str(), GetReleasesCachePath().c_str()) != 0)
+        {
+            remove(tcache.c_str());
+            remove(tmeta.c_str());
+            return;
+        }
+        if(rename(tmeta.c_str(), GetReleasesMetaPath().c_str()) != 0) remove(tmeta.c_str());
+    }
+
+    static std::size_t UpdateBodyWrite(const char *in, std::size_t size, std::size_t num, std::string *out)
+    {
+        out->append(in, (size * num));
+        return (size * num);
+    }
+
+    static std::size_t UpdateHeaderWrite(const char *in, std::size_t size, std::size_t num, std::string *etag)
+    {
+        std::string hdr(in, (size * num));
+        if(hdr.length() > 5)
+        {
+            std::string name = hdr.substr(0, 5);
+            std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+            if(name == "etag:")
+            {
+                std::string val = hdr.substr(5);
+                size_t vstart = val.find_first_not_of(" \t");
+                size_t vend = val.find_last_not_of(" \t\r\n");
+                if((vstart != std::string::npos) && (vend != std::string::npos)) *etag = val.substr(vstart, (vend - vstart + 1));
+            }
+        }
+        return (size * num);
+    }
+
+    static int UpdateProgress(void *Data, curl_off_t TotalToDownload, curl_off_t NowDownloaded, curl_off_t TotalToUpload, curl_off_t NowUploaded)
+    {
+        mutexLock(&updlock);
+        bool cancel = updcancel;
+        mutexUnlock(&updlock);
+        return (cancel ? 1 : 0);
+    }
+
+    static long RetrieveReleases(std::string URL, std::string IfNoneMatch, std::string &Out, std::string &ETag)
+    {
+        long code = 0;
+        CURL *curl = AcquireHandle(URL);
+        if(curl == NULL) return code;
+        curl_slist *headerdata = NULL;
+        headerdata = curl_slist_append(headerdata, "Accept: application/json");
+        if(!IfNoneMatch.empty()) headerdata = curl_slist_append(headerdata, ("If-None-Match: " + IfNoneMatch).c_str());
+        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headerdata);
+        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 10L);
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT, 30L);
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, UpdateBodyWrite);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &Out);
+        curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, UpdateHeaderWrite);
+        curl_easy_setopt(curl, CURLOPT_HEADERDATA, &ETag);
+        curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+        curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, UpdateProgress);
+        if(curl_easy_perform(curl) == CURLE_OK) curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &code);
+        ReleaseHandle(curl);
+        curl_slist_free_all(headerdata);
+        return code;
+    }
+
+    void SetReleasesEndpoint(std::string URL)
+    {
+        mutexLock(&updlock);
+        updendpoint = URL;
+        mutexUnlock(&updlock);
+    }
+
+    std::string GetReleasesEndpoint()
+    {
+        mutexLock(&updlock);
+        std::string ep = updendpoint;
+        mutexUnlock(&updlock);
+        return ep;
+    }
+
+    std::string FetchReleases(bool ForceRefresh)
+    {
+        std::string ep = GetReleasesEndpoint();
+        std::string cached;
+        std::string etag;
+        u64 stamp = 0;
+        bool hascache = ReadReleasesCache(ep, cached, etag, stamp);
+        u64 now = time(NULL);
+        if(hascache && !ForceRefresh && (now >= stamp) && ((now - stamp) < ReleasesCacheTTL)) return cached;
+        if(!HasConnection()) return cached;
+        std::string js;
+        std::string netag;
+        long code = RetrieveReleases(ep, (hascache ? etag : ""), js, netag);
+        if((code == 304) && hascache)
+        {
+            WriteReleasesCache(ep, cached, etag, now);
+            return cached;
+        }
+        if((code == 200) && !js.empty())
+        {
+            WriteReleasesCache(ep, js, netag, now);
+            return js;
+        }
+        return cached;
+    }
+
+    bool ParseLatestRelease(std::string JSON, std::string &LatestId)
+    {
+        json j = json::parse(JSON, nullptr, false);
+        if(j.is_discarded() || !j.is_array() || j.empty()) return false;
+        if(!j[0].is_object() || !j[0].count("tag_name") || !j[0]["tag_name"].is_string()) return false;
+        LatestId = j[0]["tag_name"].get<std::string>();
+        return true;
+    }
+
+    static void UpdateCheckProcess(void *Args)
+    {
+        UpdateCheckResult res;
+        res.Ok = false;
+        res.HasUpdate = false;
+        std::string latestid;
+        if(ParseLatestRelease(FetchReleases(), latestid))
+        {
+            Version latestv = Version::FromString(latestid);
+            Version currentv = Version::FromString("0.3");
+            res.Ok = true;
+            res.HasUpdate = latestv.IsLower(currentv);
+            res.LatestVersion = latestid;
+        }
+        mutexLock(&updlock);
+        updresult = res;
+        updstate = UpdateCheckState::Finished;
+        updpending = true;
+        mutexUnlock(&updlock);
+    }
+
+    void StartUpdateCheck()
+    {
+        mutexLock(&updlock);
+        if(updstate == UpdateCheckState::Running)
+        {
+            mutexUnlock(&updlock);
+            return;
+        }
+        updstate = UpdateCheckState::Running;
+        updpending = false;
+        updcancel = false;
+        mutexUnlock(&updlock);
+        if(updthread != NULL)
+        {
+            updthread->Join();
+            delete updthread;
+        }
+        updthread = new horizon::Thread(&UpdateCheckProcess, 0x20000);
+        if(updthread->Start() != 0)
+        {
+            delete updthread;
+            updthread = NULL;
+            mutexLock(&updlock);
+            updstate = UpdateCheckState::Idle;
+            mutexUnlock(&updlock);
+        }
+    }
+
+    UpdateCheckState GetUpdateCheckState()
+    {
+        mutexLock(&updlock);
+        UpdateCheckState st = updstate;
+        mutexUnlock(&updlock);
+        return st;
+    }
+
+    bool ConsumeUpdateCheckResult(UpdateCheckResult &Out)
+    {
+        mutexLock(&updlock);
+        bool pend = updpending;
+        if(pend) Out = updresult;
+        updpending = false;
+        mutexUnlock(&updlock);
+        return pend;
+    }
+
+    void StopUpdateCheck()
+    {
+        if(updthread == NULL) return;
+        mutexLock(&updlock);
+        updcancel = true;
+        mutexUnlock(&updlock);
+        updthread->Join();
+        delete updthread;
+        updthread = NULL;
+        mutexLock(&updlock);
+        updcancel = false;
+        if(updstate == UpdateCheckState::Running) updstate = UpdateCheckState::Idle;
+        mutexUnlock(&updlock);
+    }
+}
\ No newline at end of file
@@ -8,7 +8,7 @@
 
 namespace gleaf::nsp
 {
-    int BuildPFS(std::string ContentsDir, std::string OutPFS, std::function<void(u8 Percentage)> Callback)
+    int BuildPFS(std::string ContentsDir, std::string OutPFS, Progress &Prog)
     {
         struct dirent *cur_dirent = NULL;
         struct stat objstats;
@@ -78,6 +78,7 @@ namespace gleaf::nsp
             fwrite(fsentries, 1, sizeof(PFSFileEntry)*objcount, fout);
             fwrite(stringtable, 1, stringtable_offset, fout);
             stringtable_offset = 0;
+            Prog.SetTotal(filedata_reloffset, objcount);
             for(pos = 0; pos < objcount; pos++)
             {
                 tmplen = strlen(&stringtable[stringtable_offset]);
@@ -102,20 +103,29 @@ namespace gleaf::nsp
                     break;
                 }
                 u64 rsize = fs::GetFileSystemOperationsBufferSize();
-                u64 szread = 0;
                 u64 szrem = fsentries[pos].Size;
                 u8 *tmpbuf = fs::GetFileSystemOperationsBuffer();
                 while(szrem)
                 {
+                    if(!Prog.CheckPoint())
+                    {
+                        ret = 3;
+                        break;
+                    }
                     u64 rrsize = std::min(rsize, szrem);
                     tmplen = fread(tmpbuf, 1, rrsize, fin);
+                    if(tmplen != rrsize)
+                    {
+                        ret = 4;
+                        break;
+                    }
                     szrem -= tmplen;
-                    szread += tmplen;
                     fwrite(tmpbuf, 1, tmplen, fout);
-                    u8 pc = (u8)((double)szread / (double)fsentries[pos].Size * 100.0);
-                    Callback(pc);
+                    Prog.Advance(tmplen);
                 }
                 fclose(fin);
+                if(ret != 0) break;
+                Prog.CompleteItem();
             }
         }
         fclose(fout);
@@ -29,7 +29,6 @@ namespace gleaf::nsp
             std::string cnmtnca;
             u32 idxcnmtnca = 0;
             u64 scnmtnca = 0;
-            std::string tik;
             u32 idxtik = 0;
             stik = 0;
             auto files = nspentry.GetFiles();
@@ -54,7 +53,7 @@ namespace gleaf::nsp
             nsys->CreateDirectory("Contents/temp");
             std::string ncnmtnca = nsys->FullPathFor("Contents/temp/" + cnmtnca);
             nsys->DeleteFile(ncnmtnca);
-            nspentry.SaveFile(idxcnmtnca, nsys, ncnmtnca);
+            if(!nspentry.SaveFile(idxcnmtnca, nsys, ncnmtnca)) return err::Make(err::ErrorDescription::ReadFailed);
             std::string acnmtnca = "@SystemContent://temp/" + cnmtnca;
             acnmtnca.reserve(FS_MAX_PATH);
             ByteBuffer bcnmt;
@@ -82,7 +81,6 @@ namespace gleaf::nsp
             record.NCAId = horizon::GetNCAIdFromString(icnmtnca);
             *(u64*)record.Size = (scnmtnca & 0xffffffffffff);
             record.Type = ncm::ContentType::Meta;
-            u64 baseappid;
 
             memset(&mrec, 0, sizeof(NcmMetaRecord));
             cnmt = ncm::ContentMeta(bcnmt.GetData(), bcnmt.GetSize());
@@ -110,7 +108,7 @@ namespace gleaf::nsp
             std::string ptik = nsys->FullPathFor(nstik);
             if(stik > 0)
             {
-                nspentry.SaveFile(idxtik, nsys, ptik);
+                if(!nspentry.SaveFile(idxtik, nsys, ptik)) return err::Make(err::ErrorDescription::ReadFailed);
                 entrytik = horizon::ReadTicket(ptik);
             }
             std::string ncontrolnca;
@@ -123,7 +121,7 @@ namespace gleaf::nsp
                     std::string controlnca = controlncaid + ".nca";
                     u32 idxcontrolnca = nspentry.GetFileIndexByName(controlnca);
                     ncontrolnca = nsys->FullPathFor("Contents/temp/" + controlnca);
-                    nspentry.SaveFile(idxcontrolnca, nsys, ncontrolnca);
+                    if(!nspentry.SaveFile(idxcontrolnca, nsys, ncontrolnca)) return err::Make(err::ErrorDescription::ReadFailed);
                     std::string acontrolnca = "@SystemContent://temp/" + controlnca;
                     acontrolnca.reserve(FS_MAX_PATH);
                     FsFileSystem controlncafs;
@@ -151,7 +149,8 @@ namespace gleaf::nsp
         return rc;
     }
 
-    Result Installer::PreProcessContents()
+    // Runs once every NCA is in place, so a cancelled or failed write leaves nothing registered; a failure here undoes its own steps
+    Result Installer::RegisterContents()
     {
         fs::Explorer *nsys = fs::GetNANDSystemExplorer();
         NcmContentMetaDatabase mdb;
@@ -159,46 +158,50 @@ namespace gleaf::nsp
         if(rc != 0) return rc;
         cnmt.GetInstallContentMeta(ccnmt, record, gsets.IgnoreRequiredFirmwareVersion);
         rc = ncmContentMetaDatabaseSet(&mdb, &mrec, ccnmt.GetSize(), (NcmContentMetaRecordsHeader*)ccnmt.GetData());
+        if(rc == 0) rc = ncmContentMetaDatabaseCommit(&mdb);
         if(rc != 0)
         {
             serviceClose(&mdb.s);
             return rc;
         }
-        rc = ncmContentMetaDatabaseCommit(&mdb);
-        serviceClose(&mdb.s);
-        if(rc != 0) return rc;
+        std::vector<ns::ContentStorageRecord> orecs;
         auto res1 = ns::CountApplicationContentMeta(baseappid);
         rc = std::get<0>(res1);
         if(rc == 0x410) rc = 0;
-        if(rc != 0) return rc;
-        u32 cmetacount = std::get<1>(res1);
-        std::vector<ns::ContentStorageRecord> srecs;
+        u32 cmetacount = ((rc == 0) ? std::get<1>(res1) : 0);
         if(cmetacount > 0)
         {
-            size_t csbufs = (cmetacount * sizeof(ns::ContentStorageRecord));
-            ns::ContentStorageRecord *csbuf = (ns::ContentStorageRecord*)malloc(csbufs);
-            auto res2 = ns::ListApplicationRecordContentMeta(0, baseappid, csbuf, csbufs);
+            orecs.resize(cmetacount);
+            auto res2 = ns::ListApplicationRecordContentMeta(0, baseappid, orecs.data(), orecs.size() * sizeof(ns::ContentStorageRecord));
             rc = std::get<0>(res2);
-            if(rc != 0)
-            {
-                free(csbuf);
-                return rc;
-            }
-            for(u32 i = 0; i < cmetacount; i++) srecs.push_back(csbuf[i]);
-            free(csbuf);
         }
-        ns::ContentStorageRecord csrecord;
-        csrecord.Record = mrec;
-        csrecord.StorageId = storage;
-        srecs.push_back(csrecord);
-        ns::DeleteApplicationRecord(baseappid);
-        rc = ns::PushApplicationRecord(baseappid, 3, srecs.data(), srecs.size() * sizeof(ns::ContentStorageRecord));
-        if(rc != 0) return rc;
-        if(stik > 0)
+        bool recdeleted = false;
+        if(rc == 0)
+        {
+            std::vector<ns::ContentStorageRecord> srecs = orecs;
+            ns::ContentStorageRecord csrecord;
+            csrecord.Record = mrec;
+            csrecord.StorageId = storage;
+            srecs.push_back(csrecord);
+            ns::DeleteApplicationRecord(baseappid);
+            recdeleted = true;
+            rc = ns::PushApplicationRecord(baseappid, 3, srecs.data(), srecs.size() * sizeof(ns::ContentStorageRecord));
+        }
+        if((rc == 0) && (stik > 0))
         {
             auto tdata = nsys->ReadFile("Contents/temp/" + tik);
             es::ImportTicket(tdata.data(), tdata.size(), es::CertData, 1792);
         }
+        if(rc != 0)
+        {
+            if(recdeleted)
+            {
+                ns::DeleteApplicationRecord(baseappid);
+                if(!orecs.empty()) ns::PushApplicationRecord(baseappid, 3, orecs.data(), orecs.size() * sizeof(ns::ContentStorageRecord));
+            }
+            if(ncmContentMetaDatabaseRemove(&mdb, &mrec) == 0) ncmContentMetaDatabaseCommit(&mdb);
+        }
+        serviceClose(&mdb.s);
         return rc;
     }
 
@@ -237,12 +240,22 @@ namespace gleaf::nsp
         return ncas;
     }
 
-    Result Installer::WriteContents(std::function<void(ncm::ContentRecord Record, u32 Content, u32 ContentCount, double Done, double Total, u64 BytesSec)> OnContentWrite)
+    Result Installer::WriteContents(std::function<void(ncm::ContentRecord Record, u32 Content, u32 ContentCount)> OnContentStart, Progress &Prog)
     {
         fs::Explorer *nsys = fs::GetNANDSystemExplorer();
         Result rc = 0;
         u64 reads = fs::GetFileSystemOperationsBufferSize();
         u8 *rdata = fs::GetFileSystemOperationsBuffer();
+        u64 totalsize = 0;
+        for(u32 i = 0; i < ncas.size(); i++)
+        {
+            std::string ncaname = horizon::GetStringFromNCAId(ncas[i].NCAId);
+            if(ncas[i].Type == ncm::ContentType::Meta) ncaname += ".cnmt";
+            ncaname += ".nca";
+            totalsize += nspentry.GetFileSize(nspentry.GetFileIndexByName(ncaname));
+        }
+        Prog.SetTotal(totalsize, ncas.size());
+        std::vector<NcmNcaId> written;
         for(u32 i = 0; i < ncas.size(); i++)
         {
             ncm::ContentRecord rnca = ncas[i];
@@ -256,21 +269,13 @@ namespace gleaf::nsp
             ncmOpenContentStorage(storage, &cst);
             ncm::DeletePlaceHolder(&cst, &curid);
             ncm::CreatePlaceHolder(&cst, &curid, &curid, ncasize);
+            OnContentStart(rnca, i, ncas.size());
             u64 noff = 0;
             u64 szrem = ncasize;
-            u64 tmpwritten = 0;
-            u64 bsec = 0;
-            auto t1 = std::chrono::steady_clock::now();
+            bool rok = true;
             while(szrem)
             {
-                auto t2 = std::chrono::steady_clock::now();
-                u64 diff = std::chrono::duration_cast<std::chrono::seconds>(t2 - t1).count();
-                if(diff >= 1)
-                {
-                    t1 = t2;
-                    bsec = tmpwritten;
-                    tmpwritten = 0;
-                }
+                if(!Prog.CheckPoint()) break;
                 u64 rbytes = 0;
                 u64 rsize = std::min(szrem, reads);
                 switch(rnca.Type)
@@ -283,17 +288,40 @@ namespace gleaf::nsp
                         rbytes = nspentry.ReadFromFile(idxncaname, noff, rsize, rdata);
                         break;   
                 }
+                // A short read (e.g. a dropped HTTP source) must never be registered as a complete NCA
+                if(rbytes != rsize)
+                {
+                    rok = false;
+                    break;
+                }
                 ncm::WritePlaceHolder(&cst, &curid, noff, rdata, rbytes);
                 noff += rbytes;
-                tmpwritten += (double)rbytes;
                 szrem -= rbytes;
-                OnContentWrite(rnca, i, ncas.size(), (double)noff, (double)ncasize, bsec);
+                Prog.Advance(rbytes);
+            }
+            if(Prog.IsCancelled() || !rok)
+            {
+                ncm::DeletePlaceHolder(&cst, &curid);
+                for(u32 j = 0; j < written.size(); j++) ncmContentStorageDelete(&cst, &written[j]);
+                serviceClose(&cst.s);
+                return err::Make(rok ? err::ErrorDescription::OperationCancelled : err::ErrorDescription::ReadFailed);
             }
             ncmContentStorageRegister(&cst, &curid, &curid);
             ncm::DeletePlaceHolder(&cst, &curid);
             serviceClose(&cst.s);
+            written.push_back(curid);
+            Prog.CompleteItem();
+        }
+        rc = this->RegisterContents();
+        if(rc != 0)
+        {
+            NcmContentStorage cst;
+            if(ncmOpenContentStorage(storage, &cst) == 0)
+            {
+                for(u32 j = 0; j < written.size(); j++) ncmContentStorageDelete(&cst, &written[j]);
+                serviceClose(&cst.s);
+            }
         }
-        
         return rc;
     }
 
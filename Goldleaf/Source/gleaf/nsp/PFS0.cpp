@@ -83,7 +83,7 @@ namespace gleaf::nsp
         return this->files[Index].Entry.Size;
     }
 
-    void PFS0::SaveFile(u32 Index, fs::Explorer *Exp, std::string Path)
+    bool PFS0::SaveFile(u32 Index, fs::Explorer *Exp, std::string Path)
     {
         u64 fsize = this->GetFileSize(Index);
         u64 rsize = fs::GetFileSystemOperationsBufferSize();
@@ -92,14 +92,23 @@ namespace gleaf::nsp
         u64 off = 0;
         Exp->DeleteFile(Path);
         Exp->CreateFile(Path);
+        Exp->StartFile(Path);
         while(szrem)
         {
             u64 tread = std::min(rsize, szrem);
             u64 rbytes = this->ReadFromFile(Index, off, tread, bdata);
+            if(rbytes != tread)
+            {
+                Exp->EndFile();
+                Exp->DeleteFile(Path);
+                return false;
+            }
             Exp->WriteFileBlock(Path, bdata, rbytes);
             off += rbytes;
             szrem -= rbytes;
         }
+        Exp->EndFile();
+        return true;
     }
 
     u32 PFS0::GetFileIndexByName(std::string File)
@@ -61,6 +61,7 @@ namespace gleaf::set
         gset.KeysPath = "sdmc:/switch/prod.keys";
         gset.RomFsReplacePath = "";
         gset.MenuItemSize = 80;
+        gset.TaskPoolSelfCheck = false;
         ColorSetId csid = ColorSetId_Light;
         setsysGetColorSetId(&csid);
         if(csid == ColorSetId_Dark) gset.CustomScheme = ui::DefaultDark;
@@ -81,6 +82,8 @@ namespace gleaf::set
             }
             gset.KeysPath = "sdmc:/" + inir.Get("General", "keysPath", "switch/prod.keys");
             gset.IgnoreRequiredFirmwareVersion = inir.GetBoolean("NSP", "ignoreRequiredFwVer", true);
+            gset.ReleasesEndpoint = inir.Get("Network", "releasesEndpoint", "");
+            gset.TaskPoolSelfCheck = inir.GetBoolean("Debug", "taskPoolSelfCheck", false);
             bool rrom = inir.GetBoolean("UI", "romfsReplace", false);
             if(rrom)
             {
@@ -1,9 +1,86 @@
 #include <gleaf/set/Strings.hpp>
+#include <cstring>
 
 extern gleaf::set::Settings gsets;
 
 namespace gleaf::set
 {
+    static Dictionary MainDictionary;
+    static Dictionary Errors;
+
+    static bool BindTable(Dictionary &Dict)
+    {
+        Dict.Count = 0;
+        if(Dict.Data.size() < 12) return false;
+        if(memcmp(Dict.Data.data(), "GLST", 4) != 0) return false;
+        u32 count = *(u32*)&Dict.Data[4];
+        u64 hsize = 8 + ((u64)(count + 1) * sizeof(u32));
+        if(Dict.Data.size() < hsize) return false;
+        Dict.Offsets = (const u32*)&Dict.Data[8];
+        Dict.Strings = (const char*)&Dict.Data[hsize];
+        if(Dict.Offsets[count] != (Dict.Data.size() - hsize)) return false;
+        Dict.Count = count;
+        return true;
+    }
+
+    static bool LoadBinaryTable(Dictionary &Dict, std::string Path)
+    {
+        FILE *f = fopen(Path.c_str(), "rb");
+        if(!f) return false;
+        fseek(f, 0, SEEK_END);
+        u64 fsize = ftell(f);
+        rewind(f);
+        Dict.Data.resize(fsize);
+        u64 rsize = fread(Dict.Data.data(), 1, fsize, f);
+        fclose(f);
+        if(rsize != fsize) return false;
+        return BindTable(Dict);
+    }
+
+    static bool LoadJSONTable(Dictionary &Dict, std::string Path)
+    {
+        std::ifstream ifs(Path);
+        if(!ifs.good()) return false;
+        json strs = json::parse(ifs, nullptr, false);
+        ifs.close();
+        if(!strs.is_array()) return false;
+        u32 count = strs.size();
+        std::vector<u32> offs;
+        std::string data;
+        offs.reserve(count + 1);
+        for(u32 i = 0; i < count; i++)
+        {
+            offs.push_back(data.length());
+            if(strs[i].is_string()) data += strs[i].get<std::string>();
+            data.push_back('\0');
+        }
+        offs.push_back(data.length());
+        Dict.Data.resize(8 + (offs.size() * sizeof(u32)) + data.length());
+        memcpy(Dict.Data.data(), "GLST", 4);
+        memcpy(&Dict.Data[4], &count, sizeof(u32));
+        memcpy(&Dict.Data[8], offs.data(), offs.size() * sizeof(u32));
+        memcpy(&Dict.Data[8 + (offs.size() * sizeof(u32))], data.data(), data.length());
+        return BindTable(Dict);
+    }
+
+    static void LoadDictionary(Dictionary &Dict, std::string Base)
+    {
+        Dict.DictLanguage = gsets.CustomLanguage;
+        std::string pbin = gsets.PathForResource(Base + ".bin");
+        std::string pjson = gsets.PathForResource(Base + ".json");
+        // A replaced JSON without its own compiled table takes priority over the RomFs one
+        bool jsonrepl = (pjson.substr(0, 6) != "romfs:") && (pbin.substr(0, 6) == "romfs:");
+        if(!jsonrepl && LoadBinaryTable(Dict, pbin)) return;
+        if(LoadJSONTable(Dict, pjson)) return;
+        LoadBinaryTable(Dict, pbin);
+    }
+
+    static std::string_view GetTableEntry(Dictionary &Dict, u32 Index)
+    {
+        if(Index >= Dict.Count) return std::string_view();
+        return std::string_view(Dict.Strings + Dict.Offsets[Index], Dict.Offsets[Index + 1] - Dict.Offsets[Index] - 1);
+    }
+
     void Initialize()
     {
         std::string pdict;
@@ -25,24 +102,27 @@ namespace gleaf::set
                 pdict = "it";
                 break;
         }
-        pdict += ".json";
-        std::ifstream ifs(gsets.PathForResource("/Language/Strings/" + pdict));
-        MainDictionary.DictLanguage = gsets.CustomLanguage;
-        MainDictionary.Strings = json::parse(ifs);
-        ifs.close();
-        ifs.open(gsets.PathForResource("/Language/Errors/" + pdict));
-        Errors.DictLanguage = gsets.CustomLanguage;
-        Errors.Strings = json::parse(ifs);
-        ifs.close();
+        LoadDictionary(MainDictionary, "/Language/Strings/" + pdict);
+        LoadDictionary(Errors, "/Language/Errors/" + pdict);
+    }
+
+    std::string_view GetDictionaryView(u32 Index)
+    {
+        return GetTableEntry(MainDictionary, Index);
+    }
+
+    std::string_view GetErrorView(u32 Index)
+    {
+        return GetTableEntry(Errors, Index);
     }
     
     std::string GetDictionaryEntry(u32 Index)
     {
-        return MainDictionary.Strings[Index].get<std::string>();
+        return std::string(GetDictionaryView(Index));
     }
 
     std::string GetErrorEntry(u32 Index)
     {
-        return Errors.Strings[Index].get<std::string>();
+        return std::string(GetErrorView(Index));
     }
-}
+}
\ No newline at end of file
@@ -23,10 +23,10 @@ namespace gleaf::ui
         this->optionsMenu->ClearItems();
         if(!this->tcontents.empty()) for(u32 i = 0; i < this->tcontents.size(); i++)
         {
-            std::string name = set::GetDictionaryEntry(261);
-            if(this->tcontents[i].IsUpdate()) name = set::GetDictionaryEntry(262);
-            if(this->tcontents[i].IsDLC()) name = set::GetDictionaryEntry(263);
-            pu::element::MenuItem *subcnt = new pu::element::MenuItem(name);
+            std::string_view name = set::GetDictionaryView(261);
+            if(this->tcontents[i].IsUpdate()) name = set::GetDictionaryView(262);
+            if(this->tcontents[i].IsDLC()) name = set::GetDictionaryView(263);
+            pu::element::MenuItem *subcnt = new pu::element::MenuItem(std::string(name));
             subcnt->SetColor(gsets.CustomScheme.Text);
             subcnt->AddOnClick(std::bind(&ContentInformationLayout::options_Click, this));
             this->optionsMenu->AddItem(subcnt);
@@ -46,22 +46,22 @@ namespace gleaf::ui
         switch(cnt.Type)
         {
             case ncm::ContentMetaType::Application:
-                msg += set::GetDictionaryEntry(171);
+                msg += set::GetDictionaryView(171);
                 break;
             case ncm::ContentMetaType::AddOnContent:
-                msg += set::GetDictionaryEntry(172);
+                msg += set::GetDictionaryView(172);
                 break;
             case ncm::ContentMetaType::Patch:
-                msg += set::GetDictionaryEntry(173);
+                msg += set::GetDictionaryView(173);
                 break;
             case ncm::ContentMetaType::SystemProgram:
-                msg += set::GetDictionaryEntry(174);
+                msg += set::GetDictionaryView(174);
                 break;
             case ncm::ContentMetaType::SystemData:
-                msg += set::GetDictionaryEntry(175);
+                msg += set::GetDictionaryView(175);
                 break;
             default:
-                msg += set::GetDictionaryEntry(176);
+                msg += set::GetDictionaryView(176);
                 break;
         }
         msg += "\n" + set::GetDictionaryEntry(90) + " " + horizon::FormatApplicationId(cnt.ApplicationId);
@@ -86,7 +86,19 @@ namespace gleaf::ui
             mainapp->CreateShowDialog(set::GetDictionaryEntry(243), msg, { set::GetDictionaryEntry(234) }, true, icn);
             return;
         }
-        if(hastik) opts.push_back("Remove ticket");
+        int moveopt = -1;
+        int tikopt = -1;
+        Storage mdest = ((cnt.Location == Storage::SdCard) ? Storage::NANDUser : Storage::SdCard);
+        if((cnt.Location == Storage::SdCard) || (cnt.Location == Storage::NANDUser))
+        {
+            moveopt = opts.size();
+            opts.push_back(set::GetDictionaryEntry((mdest == Storage::SdCard) ? 287 : 288));
+        }
+        if(hastik)
+        {
+            tikopt = opts.size();
+            opts.push_back("Remove ticket");
+        }
         opts.push_back(set::GetDictionaryEntry(18));
         int sopt = mainapp->CreateShowDialog(set::GetDictionaryEntry(243), msg, opts, true, icn);
         if(sopt < 0) return;
@@ -121,11 +133,16 @@ namespace gleaf::ui
             {
                 mainapp->LoadLayout(mainapp->GetTitleDumperLayout());
                 mainapp->GetTitleDumperLayout()->StartDump(cnt);
-                mainapp->UnloadMenuData();
-                mainapp->LoadLayout(mainapp->GetMainMenuLayout());
             }
         }
-        else if(hastik && (sopt == 2))
+        else if(sopt == moveopt)
+        {
+            sopt = mainapp->CreateShowDialog(set::GetDictionaryEntry(243), set::GetDictionaryEntry(289), { set::GetDictionaryEntry(111), set::GetDictionaryEntry(18) }, true);
+            if(sopt != 0) return;
+            mainapp->LoadLayout(mainapp->GetTitleDumperLayout());
+            mainapp->GetTitleDumperLayout()->StartMove(cnt, mdest);
+        }
+        else if(sopt == tikopt)
         {
             sopt = mainapp->CreateShowDialog(set::GetDictionaryEntry(200), set::GetDictionaryEntry(205), { set::GetDictionaryEntry(111), set::GetDictionaryEntry(18) }, true);
             if(sopt < 0) return;
@@ -174,20 +191,17 @@ namespace gleaf::ui
             }
             tts.clear();
         }
-        NacpStruct *nacp = Content.TryGetNACP();
+        auto cdata = Content.GetControlData();
         std::string tcnt = horizon::FormatApplicationId(Content.ApplicationId);
-        if(nacp != NULL)
-        {
-            tcnt = horizon::GetNACPName(nacp) + " (" + std::string(nacp->version) + ")";
-            free(nacp);
-        }
         std::string icon;
-        u8 *cicon = Content.TryGetIcon();
-        if(cicon != NULL)
+        if(cdata != NULL)
         {
-            icon = horizon::GetExportedIconPath(Content.ApplicationId);
-            free(cicon);
-            cicon = NULL;
+            tcnt = horizon::GetNACPName(&cdata->NACP) + " (" + std::string(cdata->NACP.version) + ")";
+            if(Content.DumpControlData())
+            {
+                icon = horizon::GetExportedIconPath(Content.ApplicationId);
+                InvalidateTexture(icon);
+            }
         }
         mainapp->LoadMenuData(set::GetDictionaryEntry(187), icon, tcnt, false);
         this->UpdateElements();
@@ -30,11 +30,16 @@ namespace gleaf::ui
         this->unusedTicketsMenuItem->SetIcon(gsets.PathForResource("/Common/Ticket.png"));
         this->unusedTicketsMenuItem->SetColor(gsets.CustomScheme.Text);
         this->unusedTicketsMenuItem->AddOnClick(std::bind(&ContentManagerLayout::unusedTicketsMenuItem_Click, this));
+        this->verifyMenuItem = new pu::element::MenuItem(set::GetDictionaryEntry(281));
+        this->verifyMenuItem->SetIcon(gsets.PathForResource("/Common/Storage.png"));
+        this->verifyMenuItem->SetColor(gsets.CustomScheme.Text);
+        this->verifyMenuItem->AddOnClick(std::bind(&ContentManagerLayout::verifyMenuItem_Click, this));
         this->typesMenu->AddItem(this->sdCardMenuItem);
         this->typesMenu->AddItem(this->nandUserMenuItem);
         this->typesMenu->AddItem(this->nandSystemMenuItem);
         this->typesMenu->AddItem(this->gameCartMenuItem);
         this->typesMenu->AddItem(this->unusedTicketsMenuItem);
+        this->typesMenu->AddItem(this->verifyMenuItem);
         this->Add(this->typesMenu);
     }
 
@@ -73,4 +78,10 @@ namespace gleaf::ui
         mainapp->GetTicketManagerLayout()->UpdateElements();
         mainapp->LoadLayout(mainapp->GetTicketManagerLayout());
     }
+
+    void ContentManagerLayout::verifyMenuItem_Click()
+    {
+        mainapp->LoadLayout(mainapp->GetVerifyLayout());
+        mainapp->GetVerifyLayout()->StartVerify(this);
+    }
 }
\ No newline at end of file
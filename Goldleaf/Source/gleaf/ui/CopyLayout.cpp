@@ -8,7 +8,7 @@ namespace gleaf::ui
 
     CopyLayout::CopyLayout()
     {
-        this->infoText = new pu::element::TextBlock(150, 320, set::GetDictionaryEntry(151));
+        this->infoText = new AtlasText(150, 320, set::GetDictionaryEntry(151));
         this->infoText->SetHorizontalAlign(pu::element::HorizontalAlign::Center);
         this->infoText->SetColor(gsets.CustomScheme.Text);
         this->copyBar = new pu::element::ProgressBar(340, 360, 600, 30, 100.0f);
@@ -24,33 +24,30 @@ namespace gleaf::ui
 
     void CopyLayout::StartCopy(std::string Path, std::string NewPath, bool Directory, fs::Explorer *Exp, pu::Layout *Prev)
     {
-        if(Directory)
+        if(!Directory && Exp->IsFile(NewPath))
         {
-            fs::CopyDirectoryProgress(Path, NewPath, [&](u8 p)
+            int sopt = mainapp->CreateShowDialog(set::GetDictionaryEntry(142), set::GetDictionaryEntry(143), { set::GetDictionaryEntry(239), set::GetDictionaryEntry(18) }, true);
+            if(sopt < 0)
             {
-                this->copyBar->SetProgress(p);
-                mainapp->CallForRender();
-            });
-            mainapp->ShowNotification(set::GetDictionaryEntry(141));
+                mainapp->LoadLayout(Prev);
+                return;
+            }
         }
-        else
+        auto job = QueueJob("Copy", [Path, NewPath, Directory](Job &Self) -> Result
+        {
+            Self.SetStatus(fs::GetFileName(Path));
+            if(Directory) return fs::CopyDirectoryProgress(Path, NewPath, Self.GetProgress());
+            return fs::CopyFileProgress(Path, NewPath, Self.GetProgress());
+        });
+        mainapp->WatchJob(job, this->infoText, this->copyBar, [Directory, Prev](Job &Done)
         {
-            if(Exp->IsFile(NewPath))
+            if(Done.GetState() == JobState::Finished)
             {
-                int sopt = mainapp->CreateShowDialog(set::GetDictionaryEntry(142), set::GetDictionaryEntry(143), { set::GetDictionaryEntry(239), set::GetDictionaryEntry(18) }, true);
-                if(sopt < 0)
-                {
-                    mainapp->LoadLayout(Prev);
-                    return;
-                }
+                if(Done.GetResult() == 0) mainapp->ShowNotification(set::GetDictionaryEntry(Directory ? 141 : 240));
+                else HandleResult(Done.GetResult(), set::GetDictionaryEntry(293));
             }
-            fs::CopyFileProgress(Path, NewPath, [&](u8 p)
-            {
-                this->copyBar->SetProgress(p);
-                mainapp->CallForRender();
-            });
-            mainapp->ShowNotification(set::GetDictionaryEntry(240));
-        }
-        mainapp->LoadLayout(Prev);
+            if(Prev == mainapp->GetBrowserLayout()) mainapp->GetBrowserLayout()->UpdateElements();
+            mainapp->LoadLayout(Prev);
+        });
     }
 }
\ No newline at end of file
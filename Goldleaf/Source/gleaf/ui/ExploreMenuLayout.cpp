@@ -8,6 +8,7 @@ namespace gleaf::ui
 
     ExploreMenuLayout::ExploreMenuLayout() : pu::Layout()
     {
+        this->httpurl = "http://";
         this->mountsMenu = new pu::element::Menu(0, 160, 1280, gsets.CustomScheme.Base, gsets.MenuItemSize, (560 / gsets.MenuItemSize));
         this->mountsMenu->SetOnFocusColor(gsets.CustomScheme.BaseFocus);
         this->mountsMenu->SetOnSelectionChanged(std::bind(&ExploreMenuLayout::mountsMenu_SelectionChanged, this));
@@ -23,6 +24,10 @@ namespace gleaf::ui
         this->usbDriveMenuItem->SetIcon(gsets.PathForResource("/Common/USB.png"));
         this->usbDriveMenuItem->SetColor(gsets.CustomScheme.Text);
         this->usbDriveMenuItem->AddOnClick(std::bind(&ExploreMenuLayout::usbDrive_Click, this));
+        this->httpServerMenuItem = new pu::element::MenuItem(set::GetDictionaryEntry(294));
+        this->httpServerMenuItem->SetIcon(gsets.PathForResource("/Common/Drive.png"));
+        this->httpServerMenuItem->SetColor(gsets.CustomScheme.Text);
+        this->httpServerMenuItem->AddOnClick(std::bind(&ExploreMenuLayout::httpServer_Click, this));
         this->nandProfInfoFMenuItem = new pu::element::MenuItem("Console memory (PRODINFOF)");
         this->nandProfInfoFMenuItem->SetIcon(gsets.PathForResource("/Common/NAND.png"));
         this->nandProfInfoFMenuItem->SetColor(gsets.CustomScheme.Text);
@@ -42,6 +47,7 @@ namespace gleaf::ui
         this->mountsMenu->AddItem(this->sdCardMenuItem);
         this->mountsMenu->AddItem(this->pcDriveMenuItem);
         this->mountsMenu->AddItem(this->usbDriveMenuItem);
+        this->mountsMenu->AddItem(this->httpServerMenuItem);
         this->mountsMenu->AddItem(this->nandProfInfoFMenuItem);
         this->mountsMenu->AddItem(this->nandSafeMenuItem);
         this->mountsMenu->AddItem(this->nandUserMenuItem);
@@ -85,6 +91,26 @@ namespace gleaf::ui
         */
     }
 
+    void ExploreMenuLayout::httpServer_Click()
+    {
+        if(!net::HasConnection())
+        {
+            mainapp->CreateShowDialog(set::GetDictionaryEntry(295), set::GetDictionaryEntry(296), { set::GetDictionaryEntry(234) }, true);
+            return;
+        }
+        std::string url = AskForText(set::GetDictionaryEntry(297), this->httpurl);
+        if(url == "") return;
+        if((url.substr(0, 7) != "http://") && (url.substr(0, 8) != "https://"))
+        {
+            mainapp->CreateShowDialog(set::GetDictionaryEntry(295), set::GetDictionaryEntry(298), { set::GetDictionaryEntry(234) }, true);
+            return;
+        }
+        this->httpurl = url;
+        mainapp->GetBrowserLayout()->ChangePartitionHTTP(url);
+        mainapp->LoadMenuData(set::GetDictionaryEntry(299), "Drive", mainapp->GetBrowserLayout()->GetExplorer()->GetPresentableCwd());
+        mainapp->LoadLayout(mainapp->GetBrowserLayout());
+    }
+
     void ExploreMenuLayout::nandProdInfoF_Click()
     {
         mainapp->GetBrowserLayout()->ChangePartitionNAND(fs::Partition::PRODINFOF);
@@ -8,7 +8,7 @@ namespace gleaf::ui
 
     FileContentLayout::FileContentLayout()
     {
-        this->cntText = new pu::element::TextBlock(40, 180, "");
+        this->cntText = new AtlasText(40, 180, "");
         this->cntText->SetColor(gsets.CustomScheme.Text);
         this->cntText->SetFont(pu::render::LoadFont(gsets.PathForResource("/FileSystem/FileDataFont.ttf"), 25));
         this->Add(this->cntText);
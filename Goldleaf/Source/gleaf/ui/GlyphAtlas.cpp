@@ -0,0 +1,329 @@
+#include <gleaf/ui/GlyphAtlas.hpp>
+#include <map>
+
+namespace gleaf::ui
+{
+    static const u32 AtlasPageSize = 1024;
+    static const u32 AtlasMaxPages = 4;
+
+    static std::map<pu::render::NativeFont, GlyphAtlas*> atlases;
+    static std::map<u32, pu::render::NativeFont> sharedfonts;
+
+    static u32 DecodeUTF8(const std::string &Text, u32 &Pos)
+    {
+        u8 c = Text[Pos++];
+        if(c < 0x80) return c;
+        u32 extra = 0;
+        u32 cp = 0;
+        if((c & 0xe0) == 0xc0)
+        {
+            extra = 1;
+            cp = (c & 0x1f);
+        }
+        else if((c & 0xf0) == 0xe0)
+        {
+            extra = 2;
+            cp = (c & 0x0f);
+        }
+        else if((c & 0xf8) == 0xf0)
+        {
+            extra = 3;
+            cp = (c & 0x07);
+        }
+        else return 0xfffd;
+        for(u32 i = 0; i < extra; i++)
+        {
+            if((Pos >= Text.length()) || ((Text[Pos] & 0xc0) != 0x80)) return 0xfffd;
+            cp = ((cp << 6) | (Text[Pos++] & 0x3f));
+        }
+        return cp;
+    }
+
+    GlyphAtlas::GlyphAtlas(pu::render::NativeFont Font)
+    {
+        this->fnt = Font;
+        this->curx = 0;
+        this->cury = 0;
+        this->rowh = 0;
+    }
+
+    GlyphAtlas::~GlyphAtlas()
+    {
+        for(u32 i = 0; i < this->pages.size(); i++) SDL_DestroyTexture(this->pages[i]);
+        this->pages.clear();
+        this->glyphs.clear();
+    }
+
+    u32 GlyphAtlas::GetTextWidth(std::string Text)
+    {
+        int maxw = 0;
+        int pen = 0;
+        u16 prev = 0;
+        u32 pos = 0;
+        while(pos < Text.length())
+        {
+            u32 cp = DecodeUTF8(Text, pos);
+            if(cp == '\n')
+            {
+                if(pen > maxw) maxw = pen;
+                pen = 0;
+                prev = 0;
+                continue;
+            }
+            if(cp > 0xffff) cp = 0xfffd;
+            AtlasGlyph *glyph = this->FindGlyph((u16)cp);
+            if(glyph == NULL) continue;
+            if(prev != 0) pen += TTF_GetFontKerningSizeGlyphs(this->fnt, prev, (u16)cp);
+            pen += glyph->Advance;
+            prev = (u16)cp;
+        }
+        if(pen > maxw) maxw = pen;
+        return (u32)maxw;
+    }
+
+    u32 GlyphAtlas::GetTextHeight(std::string Text)
+    {
+        u32 lines = 1;
+        for(u32 i = 0; i < Text.length(); i++) if(Text[i] == '\n') lines++;
+        return (TTF_FontHeight(this->fnt) + ((lines - 1) * TTF_FontLineSkip(this->fnt)));
+    }
+
+    void GlyphAtlas::RenderText(std::string Text, u32 X, u32 Y, pu::draw::Color Color)
+    {
+        pu::render::NativeRenderer rend = pu::render::GetMainRenderer();
+        int ascent = TTF_FontAscent(this->fnt);
+        int skip = TTF_FontLineSkip(this->fnt);
+        int pen = 0;
+        int line = 0;
+        u16 prev = 0;
+        u32 pos = 0;
+        while(pos < Text.length())
+        {
+            u32 cp = DecodeUTF8(Text, pos);
+            if(cp == '\n')
+            {
+                pen = 0;
+                line += skip;
+                prev = 0;
+                continue;
+            }
+            if(cp > 0xffff) cp = 0xfffd;
+            AtlasGlyph *fglyph = this->FindGlyph((u16)cp);
+            if(fglyph == NULL) continue;
+            // Copied, since a later glyph may reset the atlas while this string is drawn
+            AtlasGlyph glyph = *fglyph;
+            if(prev != 0) pen += TTF_GetFontKerningSizeGlyphs(this->fnt, prev, (u16)cp);
+            prev = (u16)cp;
+            if((glyph.Source.w > 0) && (glyph.Source.h > 0))
+            {
+                pu::render::NativeTexture page = this->pages[glyph.Page];
+                SDL_SetTextureColorMod(page, Color.R, Color.G, Color.B);
+                SDL_SetTextureAlphaMod(page, Color.A);
+                SDL_Rect dst = { (int)X + pen + glyph.MinX, (int)Y + line + ascent - glyph.MaxY, glyph.Source.w, glyph.Source.h };
+                SDL_RenderCopy(rend, page, &glyph.Source, &dst);
+            }
+            pen += glyph.Advance;
+        }
+    }
+
+    void GlyphAtlas::Clear()
+    {
+        this->glyphs.clear();
+        this->curx = 0;
+        this->cury = 0;
+        this->rowh = 0;
+    }
+
+    AtlasGlyph *GlyphAtlas::FindGlyph(u16 Code)
+    {
+        auto it = this->glyphs.find(Code);
+        if(it != this->glyphs.end()) return (it->second.Valid ? &it->second : NULL);
+        AtlasGlyph glyph = {};
+        int minx = 0;
+        int maxx = 0;
+        int miny = 0;
+        int maxy = 0;
+        int adv = 0;
+        if(TTF_GlyphMetrics(this->fnt, Code, &minx, &maxx, &miny, &maxy, &adv) != 0)
+        {
+            // Missing glyphs are remembered too, so they are not looked up on every frame
+            this->glyphs[Code] = glyph;
+            return NULL;
+        }
+        glyph.Valid = true;
+        glyph.MinX = minx;
+        glyph.MaxY = maxy;
+        glyph.Advance = adv;
+        SDL_Surface *sf = TTF_RenderGlyph_Blended(this->fnt, Code, { 255, 255, 255, 255 });
+        if((sf != NULL) && (sf->w > 0) && (sf->h > 0))
+        {
+            if(sf->format->format != SDL_PIXELFORMAT_ARGB8888)
+            {
+                SDL_Surface *csf = SDL_ConvertSurfaceFormat(sf, SDL_PIXELFORMAT_ARGB8888, 0);
+                SDL_FreeSurface(sf);
+                sf = csf;
+            }
+            if((sf != NULL) && this->PlaceGlyph(sf->w, sf->h, glyph.Page, glyph.Source)) SDL_UpdateTexture(this->pages[glyph.Page], &glyph.Source, sf->pixels, sf->pitch);
+        }
+        if(sf != NULL) SDL_FreeSurface(sf);
+        this->glyphs[Code] = glyph;
+        return &this->glyphs[Code];
+    }
+
+    bool GlyphAtlas::PlaceGlyph(u32 Width, u32 Height, u32 &Page, SDL_Rect &Out)
+    {
+        if(((Width + 1) > AtlasPageSize) || ((Height + 1) > AtlasPageSize)) return false;
+        if((this->curx + Width + 1) > AtlasPageSize)
+        {
+            this->curx = 0;
+            this->cury += this->rowh;
+            this->rowh = 0;
+        }
+        u32 pidx = (this->cury / AtlasPageSize);
+        if(((this->cury % AtlasPageSize) + Height + 1) > AtlasPageSize)
+        {
+            pidx++;
+            this->curx = 0;
+            this->cury = (pidx * AtlasPageSize);
+            this->rowh = 0;
+        }
+        if(pidx >= AtlasMaxPages)
+        {
+            // Full: start over instead of growing, so memory stays bounded however many strings are shown
+            this->Clear();
+            pidx = 0;
+        }
+        if(pidx >= this->pages.size())
+        {
+            pu::render::NativeTexture page = SDL_CreateTexture(pu::render::GetMainRenderer(), SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC, AtlasPageSize, AtlasPageSize);
+            if(page == NULL) return false;
+            SDL_SetTextureBlendMode(page, SDL_BLENDMODE_BLEND);
+            this->pages.push_back(page);
+        }
+        Page = pidx;
+        Out.x = this->curx;
+        Out.y = (this->cury % AtlasPageSize);
+        Out.w = Width;
+        Out.h = Height;
+        this->curx += (Width + 1);
+        if((Height + 1) > this->rowh) this->rowh = (Height + 1);
+        return true;
+    }
+
+    GlyphAtlas *GetGlyphAtlas(pu::render::NativeFont Font)
+    {
+        auto it = atlases.find(Font);
+        if(it != atlases.end()) return it->second;
+        GlyphAtlas *atlas = new GlyphAtlas(Font);
+        atlases[Font] = atlas;
+        return atlas;
+    }
+
+    GlyphAtlas *GetSharedGlyphAtlas(u32 Size)
+    {
+        auto it = sharedfonts.find(Size);
+        pu::render::NativeFont font = NULL;
+        if(it != sharedfonts.end()) font = it->second;
+        else
+        {
+            font = pu::render::LoadSharedFont(pu::render::SharedFont::Standard, Size);
+            sharedfonts[Size] = font;
+        }
+        return GetGlyphAtlas(font);
+    }
+
+    void ClearGlyphAtlases()
+    {
+        for(auto &atlas: atlases) delete atlas.second;
+        atlases.clear();
+        for(auto &font: sharedfonts) pu::render::DeleteFont(font.second);
+        sharedfonts.clear();
+    }
+
+    AtlasText::AtlasText(u32 X, u32 Y, std::string Text, u32 FontSize) : pu::element::Element::Element()
+    {
+        this->x = X;
+        this->y = Y;
+        this->clr = { 0, 0, 0, 255 };
+        this->atlas = GetSharedGlyphAtlas(FontSize);
+        this->SetText(Text);
+    }
+
+    u32 AtlasText::GetX()
+    {
+        return this->x;
+    }
+
+    void AtlasText::SetX(u32 X)
+    {
+        this->x = X;
+    }
+
+    u32 AtlasText::GetY()
+    {
+        return this->y;
+    }
+
+    void AtlasText::SetY(u32 Y)
+    {
+        this->y = Y;
+    }
+
+    u32 AtlasText::GetWidth()
+    {
+        return this->GetTextWidth();
+    }
+
+    u32 AtlasText::GetHeight()
+    {
+        return this->GetTextHeight();
+    }
+
+    u32 AtlasText::GetTextWidth()
+    {
+        return this->tw;
+    }
+
+    u32 AtlasText::GetTextHeight()
+    {
+        return this->th;
+    }
+
+    std::string AtlasText::GetText()
+    {
+        return this->text;
+    }
+
+    void AtlasText::SetText(std::string Text)
+    {
+        this->text = Text;
+        this->tw = this->atlas->GetTextWidth(Text);
+        this->th = this->atlas->GetTextHeight(Text);
+    }
+
+    void AtlasText::SetFont(pu::render::NativeFont Font)
+    {
+        this->atlas = GetGlyphAtlas(Font);
+        this->SetText(this->text);
+    }
+
+    pu::draw::Color AtlasText::GetColor()
+    {
+        return this->clr;
+    }
+
+    void AtlasText::SetColor(pu::draw::Color Color)
+    {
+        this->clr = Color;
+    }
+
+    void AtlasText::OnRender(pu::render::Renderer *Drawer)
+    {
+        if(this->text.empty()) return;
+        this->atlas->RenderText(this->text, this->GetProcessedX(), this->GetProcessedY(), this->clr);
+    }
+
+    void AtlasText::OnInput(u64 Down, u64 Up, u64 Held, bool Touch, bool Focus)
+    {
+    }
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include <gleaf/ui/IconAtlas.hpp>
+#include <cstring>
+#include <unordered_map>
+
+namespace gleaf::ui
+{
+    struct AtlasIndexEntry
+    {
+        char Name[0x40];
+        u16 X;
+        u16 Y;
+        u16 Width;
+        u16 Height;
+    } PACKED;
+
+    static pu::render::NativeTexture atlastex = NULL;
+    static std::unordered_map<std::string, SDL_Rect> atlasicons;
+
+    bool LoadIconAtlas()
+    {
+        if(atlastex != NULL) return true;
+        FILE *f = fopen("romfs:/Atlas.idx", "rb");
+        if(!f) return false;
+        char magic[4];
+        u32 count = 0;
+        bool ok = ((fread(magic, 1, 4, f) == 4) && (memcmp(magic, "GLAT", 4) == 0) && (fread(&count, 1, sizeof(u32), f) == sizeof(u32)));
+        if(ok)
+        {
+            atlasicons.reserve(count);
+            for(u32 i = 0; i < count; i++)
+            {
+                AtlasIndexEntry ent;
+                if(fread(&ent, 1, sizeof(ent), f) != sizeof(ent))
+                {
+                    ok = false;
+                    break;
+                }
+                ent.Name[0x3f] = '\0';
+                SDL_Rect src = { ent.X, ent.Y, ent.Width, ent.Height };
+                atlasicons["romfs:/" + std::string(ent.Name)] = src;
+            }
+        }
+        fclose(f);
+        if(ok) atlastex = pu::render::LoadImage("romfs:/Atlas.png");
+        if(atlastex == NULL)
+        {
+            atlasicons.clear();
+            return false;
+        }
+        return true;
+    }
+
+    void UnloadIconAtlas()
+    {
+        if(atlastex != NULL) pu::render::DeleteTexture(atlastex);
+        atlastex = NULL;
+        atlasicons.clear();
+    }
+
+    bool FindAtlasIcon(std::string Path, AtlasIcon &Out)
+    {
+        if(atlastex == NULL) return false;
+        auto it = atlasicons.find(Path);
+        if(it == atlasicons.end()) return false;
+        Out.Texture = atlastex;
+        Out.Source = it->second;
+        return true;
+    }
+
+    void RenderAtlasIcon(AtlasIcon &Icon, u32 X, u32 Y, u32 Width, u32 Height)
+    {
+        SDL_Rect dst = { (int)X, (int)Y, (int)Width, (int)Height };
+        SDL_RenderCopy(pu::render::GetMainRenderer(), Icon.Texture, &Icon.Source, &dst);
+    }
+}
\ No newline at end of file
@@ -8,7 +8,7 @@ namespace gleaf::ui
 
     InstallLayout::InstallLayout() : pu::Layout()
     {
-        this->installText = new pu::element::TextBlock(150, 320, set::GetDictionaryEntry(151));
+        this->installText = new AtlasText(150, 320, set::GetDictionaryEntry(151));
         this->installText->SetHorizontalAlign(pu::element::HorizontalAlign::Center);
         this->installText->SetColor(gsets.CustomScheme.Text);
         this->installBar = new pu::element::ProgressBar(340, 360, 600, 30, 100.0f);
@@ -27,16 +27,9 @@ namespace gleaf::ui
         if(IsInstalledTitle()) appletBeginBlockingHomeButton(0);
         appletSetMediaPlaybackState(true);
 
-        nsp::Installer inst(Path, Exp, Location);
+        auto inst = std::make_shared<nsp::Installer>(Path, Exp, Location);
 
-        Result rc = inst.PrepareInstallation();
-        if(rc != 0)
-        {
-            HandleResult(rc, set::GetDictionaryEntry(251));
-            mainapp->LoadLayout(Prev);
-            return;
-        }
-        rc = inst.PreProcessContents();
+        Result rc = inst->PrepareInstallation();
         if(rc != 0)
         {
             HandleResult(rc, set::GetDictionaryEntry(251));
@@ -46,38 +39,38 @@ namespace gleaf::ui
 
 
         std::string info = set::GetDictionaryEntry(82) + "\n\n";
-        switch(inst.GetContentMetaType())
+        switch(inst->GetContentMetaType())
         {
             case ncm::ContentMetaType::Application:
-                info += set::GetDictionaryEntry(83);
+                info += set::GetDictionaryView(83);
                 break;
             case ncm::ContentMetaType::Patch:
-                info += set::GetDictionaryEntry(84);
+                info += set::GetDictionaryView(84);
                 break;
             case ncm::ContentMetaType::AddOnContent:
-                info += set::GetDictionaryEntry(85);
+                info += set::GetDictionaryView(85);
                 break;
             default:
-                info += set::GetDictionaryEntry(86);
+                info += set::GetDictionaryView(86);
                 break;
         }
         info += "\n";
-        horizon::ApplicationIdMask idmask = horizon::IsValidApplicationId(inst.GetApplicationId());
+        horizon::ApplicationIdMask idmask = horizon::IsValidApplicationId(inst->GetApplicationId());
         switch(idmask)
         {
             case horizon::ApplicationIdMask::Official:
-                info += set::GetDictionaryEntry(87);
+                info += set::GetDictionaryView(87);
                 break;
             case horizon::ApplicationIdMask::Homebrew:
-                info += set::GetDictionaryEntry(88);
+                info += set::GetDictionaryView(88);
                 break;
             case horizon::ApplicationIdMask::Invalid:
-                info += set::GetDictionaryEntry(89);
+                info += set::GetDictionaryView(89);
                 break;
         }
-        info += "\n" + set::GetDictionaryEntry(90) + " " + horizon::FormatApplicationId(inst.GetApplicationId());
+        info += "\n" + set::GetDictionaryEntry(90) + " " + horizon::FormatApplicationId(inst->GetApplicationId());
         info += "\n\n";
-        auto NACP = inst.GetNACP();
+        auto NACP = inst->GetNACP();
         if(NACP != NULL)
         {
             NacpLanguageEntry *lent;
@@ -95,29 +88,29 @@ namespace gleaf::ui
             info += NACP->version;
             info += "\n\n" + set::GetDictionaryEntry(93) + " ";
         }
-        auto NCAs = inst.GetNCAs();
+        auto NCAs = inst->GetNCAs();
         for(u32 i = 0; i < NCAs.size(); i++)
         {
             ncm::ContentType t = NCAs[i].Type;
             switch(t)
             {
                 case ncm::ContentType::Control:
-                    info += set::GetDictionaryEntry(166);
+                    info += set::GetDictionaryView(166);
                     break;
                 case ncm::ContentType::Data:
-                    info += set::GetDictionaryEntry(165);
+                    info += set::GetDictionaryView(165);
                     break;
                 case ncm::ContentType::LegalInformation:
-                    info += set::GetDictionaryEntry(168);
+                    info += set::GetDictionaryView(168);
                     break;
                 case ncm::ContentType::Meta:
-                    info += set::GetDictionaryEntry(163);
+                    info += set::GetDictionaryView(163);
                     break;
                 case ncm::ContentType::OfflineHTML:
-                    info += set::GetDictionaryEntry(167);
+                    info += set::GetDictionaryView(167);
                     break;
                 case ncm::ContentType::Program:
-                    info += set::GetDictionaryEntry(164);
+                    info += set::GetDictionaryView(164);
                     break;
                 default:
                     break;
@@ -125,9 +118,9 @@ namespace gleaf::ui
             if(i != (NCAs.size() - 1)) info += ", ";
         }
         
-        if(inst.HasTicket())
+        if(inst->HasTicket())
         {
-            auto Tik = inst.GetTicketData();
+            auto Tik = inst->GetTicketData();
             info += "\n\n" + set::GetDictionaryEntry(94) + "\n\n";
             info += set::GetDictionaryEntry(235) + " " + Tik.TitleKey;
             info += "\n" + set::GetDictionaryEntry(236) + " ";
@@ -182,30 +175,44 @@ namespace gleaf::ui
                     info += "(7.0.0 - 7.1.0)";
                     break;
                 default:
-                    info += set::GetDictionaryEntry(96);
+                    info += set::GetDictionaryView(96);
                     break;
             }
         }
         else info += "\n\n" + set::GetDictionaryEntry(97);
-        int sopt = mainapp->CreateShowDialog(set::GetDictionaryEntry(77), info, { set::GetDictionaryEntry(65), set::GetDictionaryEntry(18) }, true, inst.GetExportedIconPath());
+        int sopt = mainapp->CreateShowDialog(set::GetDictionaryEntry(77), info, { set::GetDictionaryEntry(65), set::GetDictionaryEntry(18) }, true, inst->GetExportedIconPath());
 
-        if(sopt == 0)
+        if(sopt != 0)
         {
-            this->installText->SetText(set::GetDictionaryEntry(146));
-            mainapp->CallForRender();
-            this->installBar->SetVisible(true);
-            rc = inst.WriteContents([&](ncm::ContentRecord Record, u32 Content, u32 ContentCount, double Done, double Total, u64 BytesSec)
+            appletSetMediaPlaybackState(false);
+            if(IsInstalledTitle()) appletEndBlockingHomeButton();
+            mainapp->LoadLayout(Prev);
+            return;
+        }
+        auto job = QueueJob("Install", [inst](Job &Self) -> Result
+        {
+            return inst->WriteContents([&](ncm::ContentRecord Record, u32 Content, u32 ContentCount)
             {
-                this->installBar->SetMaxValue(Total);
                 std::string name = set::GetDictionaryEntry(148) + " \'"  + horizon::GetStringFromNCAId(Record.NCAId);
                 if(Record.Type == ncm::ContentType::Meta) name += ".cnmt";
                 // name += ".nca\'... (NCA " + std::to_string(Content + 1) + " " + set::GetDictionaryEntry(149) + " " + std::to_string(ContentCount) + ")";
-                name += ".nca\'... (" + fs::FormatSize(BytesSec) + "/s)";
-                this->installText->SetText(name);
-                this->installBar->SetProgress(Done);
-                mainapp->CallForRender();
-            });
-        }
+                name += ".nca\'...";
+                Self.SetStatus(name);
+            }, Self.GetProgress());
+        });
+        job->SetStatus(set::GetDictionaryEntry(146));
+        mainapp->WatchJob(job, this->installText, this->installBar, [Prev](Job &Done)
+        {
+            appletSetMediaPlaybackState(false);
+            if(IsInstalledTitle()) appletEndBlockingHomeButton();
+            if(Done.GetState() == JobState::Finished)
+            {
+                if(Done.GetResult() != 0) HandleResult(Done.GetResult(), set::GetDictionaryEntry(251));
+                else mainapp->ShowNotification(set::GetDictionaryEntry(150));
+            }
+            if(Prev == mainapp->GetBrowserLayout()) mainapp->GetBrowserLayout()->UpdateElements();
+            mainapp->LoadLayout(Prev);
+        });
 
         /*
         Result rc = nsp::Install(Path, Exp, Location, [&](ncm::ContentMetaType Type, u64 ApplicationId, std::string IconPath, NacpStruct *NACP, horizon::TicketData *Tik, std::vector<ncm::ContentRecord> NCAs) -> bool
@@ -214,16 +221,16 @@ namespace gleaf::ui
             switch(Type)
             {
                 case ncm::ContentMetaType::Application:
-                    info += set::GetDictionaryEntry(83);
+                    info += set::GetDictionaryView(83);
                     break;
                 case ncm::ContentMetaType::Patch:
-                    info += set::GetDictionaryEntry(84);
+                    info += set::GetDictionaryView(84);
                     break;
                 case ncm::ContentMetaType::AddOnContent:
-                    info += set::GetDictionaryEntry(85);
+                    info += set::GetDictionaryView(85);
                     break;
                 default:
-                    info += set::GetDictionaryEntry(86);
+                    info += set::GetDictionaryView(86);
                     break;
             }
             info += "\n";
@@ -231,13 +238,13 @@ namespace gleaf::ui
             switch(idmask)
             {
                 case horizon::ApplicationIdMask::Official:
-                    info += set::GetDictionaryEntry(87);
+                    info += set::GetDictionaryView(87);
                     break;
                 case horizon::ApplicationIdMask::Homebrew:
-                    info += set::GetDictionaryEntry(88);
+                    info += set::GetDictionaryView(88);
                     break;
                 case horizon::ApplicationIdMask::Invalid:
-                    info += set::GetDictionaryEntry(89);
+                    info += set::GetDictionaryView(89);
                     break;
             }
             info += "\n" + set::GetDictionaryEntry(90) + " " + horizon::FormatApplicationId(ApplicationId);
@@ -265,22 +272,22 @@ namespace gleaf::ui
                 switch(t)
                 {
                     case ncm::ContentType::Control:
-                        info += set::GetDictionaryEntry(166);
+                        info += set::GetDictionaryView(166);
                         break;
                     case ncm::ContentType::Data:
-                        info += set::GetDictionaryEntry(165);
+                        info += set::GetDictionaryView(165);
                         break;
                     case ncm::ContentType::LegalInformation:
-                        info += set::GetDictionaryEntry(168);
+                        info += set::GetDictionaryView(168);
                         break;
                     case ncm::ContentType::Meta:
-                        info += set::GetDictionaryEntry(163);
+                        info += set::GetDictionaryView(163);
                         break;
                     case ncm::ContentType::OfflineHTML:
-                        info += set::GetDictionaryEntry(167);
+                        info += set::GetDictionaryView(167);
                         break;
                     case ncm::ContentType::Program:
-                        info += set::GetDictionaryEntry(164);
+                        info += set::GetDictionaryView(164);
                         break;
                     default:
                         break;
@@ -341,7 +348,7 @@ namespace gleaf::ui
                         info += "(7.0.0 - 7.1.0)";
                         break;
                     default:
-                        info += set::GetDictionaryEntry(96);
+                        info += set::GetDictionaryView(96);
                         break;
                 }
             }
@@ -365,12 +372,5 @@ namespace gleaf::ui
             mainapp->CallForRender();
         });
         */
-        appletSetMediaPlaybackState(false);
-        if(IsInstalledTitle()) appletEndBlockingHomeButton();
-        this->installBar->SetVisible(false);
-        mainapp->CallForRender();
-        if(rc != 0) HandleResult(rc, set::GetDictionaryEntry(251));
-        else mainapp->ShowNotification(set::GetDictionaryEntry(150));
-        mainapp->LoadLayout(Prev);
     }
 }
\ No newline at end of file
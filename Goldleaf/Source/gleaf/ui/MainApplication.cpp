@@ -12,259 +12,71 @@ namespace gleaf::ui
     MainApplication::MainApplication(StartMode Mode) : pu::Application()
     {
         this->stmode = Mode;
+        TraceStartup("Application created");
         gsets = set::ProcessSettings();
+        if(!gsets.ReleasesEndpoint.empty()) net::SetReleasesEndpoint(gsets.ReleasesEndpoint);
         set::Initialize();
         this->SetBackgroundColor(gsets.CustomScheme.Background);
+        LoadIconAtlas();
         this->preblv = 0;
         this->preisch = false;
         this->pretime = "";
         this->vfirst = true;
         this->connstate = 0;
+        this->preip = 0;
+        this->hasusb = false;
         this->baseImage = new pu::element::Image(0, 0, gsets.PathForResource("/Base.png"));
-        this->timeText = new pu::element::TextBlock(1124, 20, "00:00:00");
+        this->timeText = new AtlasText(1124, 20, "00:00:00");
         this->timeText->SetColor(gsets.CustomScheme.Text);
-        this->batteryText = new pu::element::TextBlock(1015, 22, "0%", 20);
+        this->batteryText = new AtlasText(1015, 22, "0%", 20);
         this->batteryText->SetColor(gsets.CustomScheme.Text);
-        this->batteryImage = new pu::element::Image(960, 8, gsets.PathForResource("/Battery/0.png"));
-        this->batteryChargeImage = new pu::element::Image(960, 8, gsets.PathForResource("/Battery/Charge.png"));
+        this->batteryImage = new CachedImage(960, 8, gsets.PathForResource("/Battery/0.png"));
+        this->batteryChargeImage = new CachedImage(960, 8, gsets.PathForResource("/Battery/Charge.png"));
         this->menuBanner = new pu::element::Image(10, 62, gsets.PathForResource("/MenuBanner.png"));
-        this->menuImage = new pu::element::Image(15, 69, gsets.PathForResource("/Common/SdCard.png"));
+        this->menuImage = new CachedImage(15, 69, gsets.PathForResource("/Common/SdCard.png"));
         this->menuImage->SetWidth(85);
         this->menuImage->SetHeight(85);
-        this->usbImage = new pu::element::Image(710, 12, gsets.PathForResource("/Common/USB.png"));
+        this->usbImage = new CachedImage(710, 12, gsets.PathForResource("/Common/USB.png"));
         this->usbImage->SetWidth(40);
         this->usbImage->SetHeight(40);
         this->usbImage->SetVisible(false);
-        this->connImage = new pu::element::Image(755, 12, gsets.PathForResource("/Connection/None.png"));
+        this->connImage = new CachedImage(755, 12, gsets.PathForResource("/Connection/None.png"));
         this->connImage->SetWidth(40);
         this->connImage->SetHeight(40);
         this->connImage->SetVisible(true);
-        this->ipText = new pu::element::TextBlock(800, 22, "127.0.0.1", 20);
+        this->ipText = new AtlasText(800, 22, "127.0.0.1", 20);
         this->ipText->SetColor(gsets.CustomScheme.Text);
-        this->menuNameText = new pu::element::TextBlock(120, 85, "-");
+        this->menuNameText = new AtlasText(120, 85, "-");
         this->menuNameText->SetColor(gsets.CustomScheme.Text);
-        this->menuHeadText = new pu::element::TextBlock(120, 120, "-", 20);
+        this->menuHeadText = new AtlasText(120, 120, "-", 20);
         this->menuHeadText->SetColor(gsets.CustomScheme.Text);
         this->UnloadMenuData();
         this->toast = new pu::overlay::Toast(":", 20, { 225, 225, 225, 255 }, { 40, 40, 40, 255 });
-        this->UpdateValues();
+        horizon::StartTaskPool();
+        if(gsets.TaskPoolSelfCheck) horizon::CheckTaskPool("sdmc:/goldleaf/taskpool.log");
+        StartStatusService();
+        StartJobService();
+        TraceStartup("Services started");
         this->mainMenu = new MainMenuLayout();
-        this->browser = new PartitionBrowserLayout();
-        this->browser->SetOnInput(std::bind(&MainApplication::browser_Input, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
-        this->fileContent = new FileContentLayout();
-        this->fileContent->SetOnInput(std::bind(&MainApplication::fileContent_Input, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
-        this->copy = new CopyLayout();
-        this->exploreMenu = new ExploreMenuLayout();
-        this->exploreMenu->SetOnInput(std::bind(&MainApplication::exploreMenu_Input, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
-        this->pcExplore = new PCExploreLayout();
-        this->pcExplore->SetOnInput(std::bind(&MainApplication::pcExplore_Input, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
-        this->usbDrives = new USBDrivesLayout();
-        this->usbDrives->SetOnInput(std::bind(&MainApplication::usbDrives_Input, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
-        this->nspInstall = new InstallLayout();
-        this->contentInformation = new ContentInformationLayout();
-        this->contentInformation->SetOnInput(std::bind(&MainApplication::contentInformation_Input, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
-        this->storageContents = new StorageContentsLayout();
-        this->storageContents->SetOnInput(std::bind(&MainApplication::storageContents_Input, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
-        this->contentManager = new ContentManagerLayout();
-        this->contentManager->SetOnInput(std::bind(&MainApplication::contentManager_Input, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
-        this->titleDump = new TitleDumperLayout();
-        this->ticketManager = new TicketManagerLayout();
-        this->ticketManager->SetOnInput(std::bind(&MainApplication::ticketManager_Input, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
-        this->account = new AccountLayout();
-        this->account->SetOnInput(std::bind(&MainApplication::account_Input, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
-        this->sysInfo = new SystemInfoLayout();
-        this->sysInfo->SetOnInput(std::bind(&MainApplication::sysInfo_Input, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
-        this->update = new UpdateLayout();
-        this->about = new AboutLayout();
-        this->about->SetOnInput(std::bind(&MainApplication::about_Input, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
-        this->mainMenu->Add(this->baseImage);
-        this->browser->Add(this->baseImage);
-        this->exploreMenu->Add(this->baseImage);
-        this->pcExplore->Add(this->baseImage);
-        this->usbDrives->Add(this->baseImage);
-        this->fileContent->Add(this->baseImage);
-        this->copy->Add(this->baseImage);
-        this->nspInstall->Add(this->baseImage);
-        this->contentInformation->Add(this->baseImage);
-        this->storageContents->Add(this->baseImage);
-        this->contentManager->Add(this->baseImage);
-        this->titleDump->Add(this->baseImage);
-        this->ticketManager->Add(this->baseImage);
-        this->account->Add(this->baseImage);
-        this->sysInfo->Add(this->baseImage);
-        this->update->Add(this->baseImage);
-        this->about->Add(this->baseImage);
-        this->mainMenu->Add(this->timeText);
-        this->browser->Add(this->timeText);
-        this->exploreMenu->Add(this->timeText);
-        this->pcExplore->Add(this->timeText);
-        this->usbDrives->Add(this->timeText);
-        this->fileContent->Add(this->timeText);
-        this->copy->Add(this->timeText);
-        this->nspInstall->Add(this->timeText);
-        this->contentInformation->Add(this->timeText);
-        this->storageContents->Add(this->timeText);
-        this->contentManager->Add(this->timeText);
-        this->titleDump->Add(this->timeText);
-        this->ticketManager->Add(this->timeText);
-        this->account->Add(this->timeText);
-        this->sysInfo->Add(this->timeText);
-        this->update->Add(this->timeText);
-        this->about->Add(this->timeText);
-        this->mainMenu->Add(this->batteryText);
-        this->browser->Add(this->batteryText);
-        this->exploreMenu->Add(this->batteryText);
-        this->pcExplore->Add(this->batteryText);
-        this->usbDrives->Add(this->batteryText);
-        this->fileContent->Add(this->batteryText);
-        this->copy->Add(this->batteryText);
-        this->nspInstall->Add(this->batteryText);
-        this->contentInformation->Add(this->batteryText);
-        this->storageContents->Add(this->batteryText);
-        this->contentManager->Add(this->batteryText);
-        this->titleDump->Add(this->batteryText);
-        this->ticketManager->Add(this->batteryText);
-        this->account->Add(this->batteryText);
-        this->sysInfo->Add(this->batteryText);
-        this->update->Add(this->batteryText);
-        this->about->Add(this->batteryText);
-        this->mainMenu->Add(this->batteryImage);
-        this->browser->Add(this->batteryImage);
-        this->exploreMenu->Add(this->batteryImage);
-        this->pcExplore->Add(this->batteryImage);
-        this->usbDrives->Add(this->batteryImage);
-        this->fileContent->Add(this->batteryImage);
-        this->copy->Add(this->batteryImage);
-        this->nspInstall->Add(this->batteryImage);
-        this->contentInformation->Add(this->batteryImage);
-        this->storageContents->Add(this->batteryImage);
-        this->contentManager->Add(this->batteryImage);
-        this->titleDump->Add(this->batteryImage);
-        this->ticketManager->Add(this->batteryImage);
-        this->account->Add(this->batteryImage);
-        this->sysInfo->Add(this->batteryImage);
-        this->update->Add(this->batteryImage);
-        this->about->Add(this->batteryImage);
-        this->mainMenu->Add(this->batteryChargeImage);
-        this->browser->Add(this->batteryChargeImage);
-        this->exploreMenu->Add(this->batteryChargeImage);
-        this->pcExplore->Add(this->batteryChargeImage);
-        this->usbDrives->Add(this->batteryChargeImage);
-        this->fileContent->Add(this->batteryChargeImage);
-        this->copy->Add(this->batteryChargeImage);
-        this->nspInstall->Add(this->batteryChargeImage);
-        this->contentInformation->Add(this->batteryChargeImage);
-        this->storageContents->Add(this->batteryChargeImage);
-        this->contentManager->Add(this->batteryChargeImage);
-        this->titleDump->Add(this->batteryChargeImage);
-        this->ticketManager->Add(this->batteryChargeImage);
-        this->account->Add(this->batteryChargeImage);
-        this->sysInfo->Add(this->batteryChargeImage);
-        this->update->Add(this->batteryChargeImage);
-        this->about->Add(this->batteryChargeImage);
-        this->mainMenu->Add(this->menuImage);
-        this->browser->Add(this->menuImage);
-        this->exploreMenu->Add(this->menuImage);
-        this->pcExplore->Add(this->menuImage);
-        this->usbDrives->Add(this->menuImage);
-        this->fileContent->Add(this->menuImage);
-        this->copy->Add(this->menuImage);
-        this->nspInstall->Add(this->menuImage);
-        this->contentInformation->Add(this->menuImage);
-        this->storageContents->Add(this->menuImage);
-        this->contentManager->Add(this->menuImage);
-        this->titleDump->Add(this->menuImage);
-        this->ticketManager->Add(this->menuImage);
-        this->account->Add(this->menuImage);
-        this->sysInfo->Add(this->menuImage);
-        this->update->Add(this->menuImage);
-        this->about->Add(this->menuImage);
-        this->mainMenu->Add(this->usbImage);
-        this->browser->Add(this->usbImage);
-        this->exploreMenu->Add(this->usbImage);
-        this->pcExplore->Add(this->usbImage);
-        this->usbDrives->Add(this->usbImage);
-        this->fileContent->Add(this->usbImage);
-        this->copy->Add(this->usbImage);
-        this->nspInstall->Add(this->usbImage);
-        this->contentInformation->Add(this->usbImage);
-        this->storageContents->Add(this->usbImage);
-        this->contentManager->Add(this->usbImage);
-        this->titleDump->Add(this->usbImage);
-        this->ticketManager->Add(this->usbImage);
-        this->account->Add(this->usbImage);
-        this->sysInfo->Add(this->usbImage);
-        this->update->Add(this->usbImage);
-        this->about->Add(this->usbImage);
-        this->mainMenu->Add(this->connImage);
-        this->browser->Add(this->connImage);
-        this->exploreMenu->Add(this->connImage);
-        this->pcExplore->Add(this->connImage);
-        this->usbDrives->Add(this->connImage);
-        this->fileContent->Add(this->connImage);
-        this->copy->Add(this->connImage);
-        this->nspInstall->Add(this->connImage);
-        this->contentInformation->Add(this->connImage);
-        this->storageContents->Add(this->connImage);
-        this->contentManager->Add(this->connImage);
-        this->titleDump->Add(this->connImage);
-        this->ticketManager->Add(this->connImage);
-        this->account->Add(this->connImage);
-        this->sysInfo->Add(this->connImage);
-        this->update->Add(this->connImage);
-        this->about->Add(this->connImage);
-        this->mainMenu->Add(this->ipText);
-        this->browser->Add(this->ipText);
-        this->exploreMenu->Add(this->ipText);
-        this->pcExplore->Add(this->ipText);
-        this->usbDrives->Add(this->ipText);
-        this->fileContent->Add(this->ipText);
-        this->copy->Add(this->ipText);
-        this->nspInstall->Add(this->ipText);
-        this->contentInformation->Add(this->ipText);
-        this->storageContents->Add(this->ipText);
-        this->contentManager->Add(this->ipText);
-        this->titleDump->Add(this->ipText);
-        this->ticketManager->Add(this->ipText);
-        this->account->Add(this->ipText);
-        this->sysInfo->Add(this->ipText);
-        this->update->Add(this->ipText);
-        this->about->Add(this->ipText);
-        this->mainMenu->Add(this->menuBanner);
-        this->mainMenu->Add(this->menuNameText);
-        this->browser->Add(this->menuNameText);
-        this->exploreMenu->Add(this->menuNameText);
-        this->pcExplore->Add(this->menuNameText);
-        this->usbDrives->Add(this->menuNameText);
-        this->fileContent->Add(this->menuNameText);
-        this->copy->Add(this->menuNameText);
-        this->nspInstall->Add(this->menuNameText);
-        this->contentInformation->Add(this->menuNameText);
-        this->storageContents->Add(this->menuNameText);
-        this->contentManager->Add(this->menuNameText);
-        this->titleDump->Add(this->menuNameText);
-        this->ticketManager->Add(this->menuNameText);
-        this->account->Add(this->menuNameText);
-        this->sysInfo->Add(this->menuNameText);
-        this->update->Add(this->menuNameText);
-        this->about->Add(this->menuNameText);
-        this->mainMenu->Add(this->menuHeadText);
-        this->browser->Add(this->menuHeadText);
-        this->exploreMenu->Add(this->menuHeadText);
-        this->pcExplore->Add(this->menuHeadText);
-        this->usbDrives->Add(this->menuHeadText);
-        this->fileContent->Add(this->menuHeadText);
-        this->copy->Add(this->menuHeadText);
-        this->nspInstall->Add(this->menuHeadText);
-        this->contentInformation->Add(this->menuHeadText);
-        this->storageContents->Add(this->menuHeadText);
-        this->contentManager->Add(this->menuHeadText);
-        this->titleDump->Add(this->menuHeadText);
-        this->ticketManager->Add(this->menuHeadText);
-        this->account->Add(this->menuHeadText);
-        this->sysInfo->Add(this->menuHeadText);
-        this->update->Add(this->menuHeadText);
-        this->about->Add(this->menuHeadText);
+        this->AddBaseElements(this->mainMenu, true);
+        this->browser = NULL;
+        this->fileContent = NULL;
+        this->copy = NULL;
+        this->exploreMenu = NULL;
+        this->pcExplore = NULL;
+        this->usbDrives = NULL;
+        this->nspInstall = NULL;
+        this->contentInformation = NULL;
+        this->storageContents = NULL;
+        this->contentManager = NULL;
+        this->titleDump = NULL;
+        this->ticketManager = NULL;
+        this->account = NULL;
+        this->sysInfo = NULL;
+        this->update = NULL;
+        this->about = NULL;
+        this->verify = NULL;
+        TraceStartup("Main menu created");
         this->AddThread(std::bind(&MainApplication::UpdateValues, this));
         this->SetOnInput(std::bind(&MainApplication::OnInput, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
         switch(this->stmode)
@@ -273,18 +85,22 @@ namespace gleaf::ui
                 this->LoadLayout(this->mainMenu);
                 break;
             case StartMode::Qlaunch:
-                this->LoadLayout(this->about);
+                this->LoadLayout(this->GetAboutLayout());
                 break;
             case StartMode::HomebrewMenu:
-                this->LoadLayout(this->about);
+                this->LoadLayout(this->GetAboutLayout());
                 break;
         }
         this->updshown = false;
+        this->traced = false;
         this->start = std::chrono::steady_clock::now();
     }
 
     MainApplication::~MainApplication()
     {
+        StopJobService();
+        StopStatusService();
+        horizon::StopTaskPool();
         delete this->baseImage;
         delete this->timeText;
         delete this->batteryText;
@@ -315,6 +131,25 @@ namespace gleaf::ui
         delete this->sysInfo;
         delete this->update;
         delete this->about;
+        delete this->verify;
+        ClearGlyphAtlases();
+        UnloadIconAtlas();
+    }
+
+    void MainApplication::AddBaseElements(pu::Layout *Target, bool Banner)
+    {
+        Target->Add(this->baseImage);
+        Target->Add(this->timeText);
+        Target->Add(this->batteryText);
+        Target->Add(this->batteryImage);
+        Target->Add(this->batteryChargeImage);
+        Target->Add(this->menuImage);
+        Target->Add(this->usbImage);
+        Target->Add(this->connImage);
+        Target->Add(this->ipText);
+        if(Banner) Target->Add(this->menuBanner);
+        Target->Add(this->menuNameText);
+        Target->Add(this->menuHeadText);
     }
 
     void MainApplication::ShowNotification(std::string Text)
@@ -324,18 +159,83 @@ namespace gleaf::ui
         mainapp->StartOverlayWithTimeout(this->toast, 1500);
     }
 
+    void MainApplication::WatchJob(std::shared_ptr<Job> Target, AtlasText *Text, pu::element::ProgressBar *Bar, std::function<void(Job &Done)> OnDone)
+    {
+        // An older job drawing on the same widgets keeps running and still gets its OnDone, it just stops drawing
+        for(auto &wjob: this->watched) if((wjob.Text == Text) || (wjob.Bar == Bar))
+        {
+            wjob.Text = NULL;
+            wjob.Bar = NULL;
+        }
+        this->watched.push_back({ Target, Text, Bar, OnDone, "" });
+        Bar->SetMaxValue(100);
+        Bar->SetProgress(0);
+        Bar->SetVisible(true);
+        this->UpdateJob();
+    }
+
+    void MainApplication::UpdateJob()
+    {
+        if(this->watched.empty()) return;
+        std::vector<WatchedJob> done;
+        for(auto it = this->watched.begin(); it != this->watched.end();)
+        {
+            if(it->Bar != NULL)
+            {
+                ProgressSample smp = it->Target->GetProgress().Sample();
+                it->Bar->SetProgress(smp.Percentage);
+                std::string text = it->Target->GetStatus();
+                if(smp.Throughput > 0) text += "\n(" + fs::FormatSize((u64)smp.Throughput) + "/s, " + FormatDuration(smp.ETA) + ")";
+                if(it->Target->IsPaused())
+                {
+                    text += "\n";
+                    text += set::GetDictionaryView(278);
+                }
+                text += "\n\n";
+                text += set::GetDictionaryView(277);
+                if(text != it->Last)
+                {
+                    it->Text->SetText(text);
+                    it->Last = text;
+                }
+            }
+            if(it->Target->IsDone())
+            {
+                if(it->Bar != NULL) it->Bar->SetVisible(false);
+                done.push_back(*it);
+                it = this->watched.erase(it);
+            }
+            else it++;
+        }
+        // Removed before OnDone, which may open dialogs or watch a follow-up job
+        for(auto &wjob: done)
+        {
+            if(wjob.Target->GetState() == JobState::Cancelled) this->ShowNotification(err::DetermineError(wjob.Target->GetResult()).Description);
+            if(wjob.OnDone) wjob.OnDone(*wjob.Target);
+        }
+    }
+
     void MainApplication::UpdateValues()
     {
+        if(!this->traced)
+        {
+            TraceStartup("First frame");
+            SaveStartupTrace();
+            this->traced = true;
+        }
+        this->UpdateJob();
         auto ct = std::chrono::steady_clock::now();
         auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(ct - this->start).count();
         if((diff >= 500) && (!this->updshown))
         {
-            if(net::CheckVersionDiff()) mainapp->ShowNotification("New Goldleaf updates were found. Go to the updates section to update Goldleaf.");
+            net::StartUpdateCheck();
             this->updshown = true;
         }
-        std::string dtime = horizon::GetCurrentTime();
-        u32 blv = horizon::GetBatteryLevel();
-        bool isch = horizon::IsCharging();
+        net::UpdateCheckResult upd;
+        if(net::ConsumeUpdateCheckResult(upd)) if(upd.Ok && upd.HasUpdate) mainapp->ShowNotification("New Goldleaf updates were found. Go to the updates section to update Goldleaf.");
+        StatusSnapshot st;
+        if(!ConsumeStatusChanges(st)) return;
+        u32 blv = st.BatteryLevel;
         if((this->preblv != blv) || this->vfirst)
         {
             if(blv <= 10) this->batteryImage->SetImage(gsets.PathForResource("/Battery/0.png"));
@@ -352,37 +252,41 @@ namespace gleaf::ui
             this->batteryText->SetText(std::to_string(blv) + "%");
             this->preblv = blv;
         }
-        if((this->preisch != isch) || this->vfirst)
+        if((this->preisch != st.Charging) || this->vfirst)
         {
-            if(isch) this->batteryChargeImage->SetVisible(true);
-            else this->batteryChargeImage->SetVisible(false);
-            this->preisch = isch;
+            this->batteryChargeImage->SetVisible(st.Charging);
+            this->preisch = st.Charging;
         }
-        if((this->pretime != dtime) || this->vfirst)
+        if((this->pretime != st.Time) || this->vfirst)
         {
-            this->timeText->SetText(dtime);
-            this->pretime = dtime;
+            this->timeText->SetText(st.Time);
+            this->pretime = st.Time;
         }
-        if(this->vfirst) this->vfirst = false;
-        this->hasusb = usb::IsStatePlugged();
-        this->usbImage->SetVisible(this->hasusb);
-        u32 connstr = 0;
-        Result rc = nifmGetInternetConnectionStatus(NULL, &connstr, NULL);
-        std::string connimg = "None";
-        if(rc == 0) if(connstr > 0) connimg = std::to_string(connstr);
-        if(connstr != this->connstate)
+        if((this->hasusb != st.USBPlugged) || this->vfirst)
+        {
+            this->hasusb = st.USBPlugged;
+            this->usbImage->SetVisible(this->hasusb);
+        }
+        if((st.ConnectionStrength != this->connstate) || this->vfirst)
         {
+            std::string connimg = "None";
+            if(st.ConnectionStrength > 0) connimg = std::to_string(st.ConnectionStrength);
             this->connImage->SetImage(gsets.PathForResource("/Connection/" + connimg + ".png"));
-            this->connstate = connstr;
+            this->connstate = st.ConnectionStrength;
         }
-        if(connstr > 0)
+        if((st.IPAddress != this->preip) || this->vfirst)
         {
-            u32 ip = gethostid();
-            char sip[256];
-            inet_ntop(AF_INET, &ip, sip, 256);
-            this->ipText->SetText(std::string(sip));
+            if(st.IPAddress > 0)
+            {
+                u32 ip = st.IPAddress;
+                char sip[256];
+                inet_ntop(AF_INET, &ip, sip, 256);
+                this->ipText->SetText(std::string(sip));
+            }
+            else this->ipText->SetText("<no connection>");
+            this->preip = st.IPAddress;
         }
-        else this->ipText->SetText("<no connection>");
+        if(this->vfirst) this->vfirst = false;
     }
 
     void MainApplication::LoadMenuData(std::string Name, std::string ImageName, std::string TempHead, bool CommonIcon)
@@ -426,9 +330,10 @@ namespace gleaf::ui
             {
                 this->UnloadMenuData();
                 this->LoadMenuData("Mounted content", "Storage", "Explore mounted contents");
-                this->LoadLayout(this->exploreMenu);
+                this->LoadLayout(this->GetExploreMenuLayout());
             }
         }
+        else if((Down & (KEY_X | KEY_L | KEY_R)) && this->browser->GetExplorer()->IsReadOnly()) this->ShowNotification(set::GetDictionaryEntry(300));
         else if(Down & KEY_X)
         {
             if(clipboard != "")
@@ -453,7 +358,6 @@ namespace gleaf::ui
                     std::string cname = fs::GetFileName(clipboard);
                     this->LoadLayout(this->GetCopyLayout());
                     this->GetCopyLayout()->StartCopy(clipboard, this->browser->GetExplorer()->FullPathFor(cname), cdir, this->browser->GetExplorer(), this->browser);
-                    this->browser->UpdateElements();
                     clipboard = "";
                 }
             }
@@ -508,7 +412,7 @@ namespace gleaf::ui
         {
             this->UnloadMenuData();
             this->LoadMenuData("Mounted content", "Storage", "Explore mounted contents");
-            this->LoadLayout(this->exploreMenu);
+            this->LoadLayout(this->GetExploreMenuLayout());
         }
     }
 
@@ -518,7 +422,7 @@ namespace gleaf::ui
         {
             this->UnloadMenuData();
             this->LoadMenuData("Mounted content", "Storage", "Explore mounted contents");
-            this->LoadLayout(this->exploreMenu);
+            this->LoadLayout(this->GetExploreMenuLayout());
         }
     }
 
@@ -534,7 +438,7 @@ namespace gleaf::ui
         if(Down & KEY_B)
         {
             this->LoadMenuData(set::GetDictionaryEntry(187), "Storage", set::GetDictionaryEntry(189));
-            this->LoadLayout(this->storageContents);
+            this->LoadLayout(this->GetStorageContentsLayout());
         }
     }
 
@@ -543,7 +447,7 @@ namespace gleaf::ui
         if(Down & KEY_B)
         {
             this->LoadMenuData(set::GetDictionaryEntry(187), "Storage", set::GetDictionaryEntry(33));
-            this->LoadLayout(this->contentManager);
+            this->LoadLayout(this->GetContentManagerLayout());
         }
     }
 
@@ -596,6 +500,17 @@ namespace gleaf::ui
     void MainApplication::OnInput(u64 Down, u64 Up, u64 Held)
     {
         if(((Down & KEY_PLUS) || (Down & KEY_MINUS)) && IsNRO()) this->Close();
+        else if(!this->watched.empty())
+        {
+            // Controls act on the most recently watched job, the one in front of the user
+            std::shared_ptr<Job> job = this->watched.back().Target;
+            if(Down & KEY_B) job->Cancel();
+            else if(Down & KEY_Y)
+            {
+                if(job->IsPaused()) job->Resume();
+                else job->Pause();
+            }
+        }
         else if((Down & KEY_ZL) || (Down & KEY_ZR)) ShowPowerTasksDialog(set::GetDictionaryEntry(229), set::GetDictionaryEntry(230));
     }
 
@@ -606,84 +521,186 @@ namespace gleaf::ui
 
     PartitionBrowserLayout *MainApplication::GetBrowserLayout()
     {
+        if(this->browser == NULL)
+        {
+            this->browser = new PartitionBrowserLayout();
+            this->browser->SetOnInput(std::bind(&MainApplication::browser_Input, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+            this->AddBaseElements(this->browser);
+        }
         return this->browser;
     }
 
     FileContentLayout *MainApplication::GetFileContentLayout()
     {
+        if(this->fileContent == NULL)
+        {
+            this->fileContent = new FileContentLayout();
+            this->fileContent->SetOnInput(std::bind(&MainApplication::fileContent_Input, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+            this->AddBaseElements(this->fileContent);
+        }
         return this->fileContent;
     }
 
     CopyLayout *MainApplication::GetCopyLayout()
     {
+        if(this->copy == NULL)
+        {
+            this->copy = new CopyLayout();
+            this->AddBaseElements(this->copy);
+        }
         return this->copy;
     }
 
     ExploreMenuLayout *MainApplication::GetExploreMenuLayout()
     {
+        if(this->exploreMenu == NULL)
+        {
+            this->exploreMenu = new ExploreMenuLayout();
+            this->exploreMenu->SetOnInput(std::bind(&MainApplication::exploreMenu_Input, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+            this->AddBaseElements(this->exploreMenu);
+        }
         return this->exploreMenu;
     }
 
     PCExploreLayout *MainApplication::GetPCExploreLayout()
     {
+        if(this->pcExplore == NULL)
+        {
+            this->pcExplore = new PCExploreLayout();
+            this->pcExplore->SetOnInput(std::bind(&MainApplication::pcExplore_Input, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+            this->AddBaseElements(this->pcExplore);
+        }
         return this->pcExplore;
     }
 
     USBDrivesLayout *MainApplication::GetUSBDrivesLayout()
     {
+        if(this->usbDrives == NULL)
+        {
+            this->usbDrives = new USBDrivesLayout();
+            this->usbDrives->SetOnInput(std::bind(&MainApplication::usbDrives_Input, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+            this->AddBaseElements(this->usbDrives);
+        }
         return this->usbDrives;
     }
 
     InstallLayout *MainApplication::GetInstallLayout()
     {
+        if(this->nspInstall == NULL)
+        {
+            this->nspInstall = new InstallLayout();
+            this->AddBaseElements(this->nspInstall);
+        }
         return this->nspInstall;
     }
 
     ContentInformationLayout *MainApplication::GetContentInformationLayout()
     {
+        if(this->contentInformation == NULL)
+        {
+            this->contentInformation = new ContentInformationLayout();
+            this->contentInformation->SetOnInput(std::bind(&MainApplication::contentInformation_Input, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+            this->AddBaseElements(this->contentInformation);
+        }
         return this->contentInformation;
     }
 
     StorageContentsLayout *MainApplication::GetStorageContentsLayout()
     {
+        if(this->storageContents == NULL)
+        {
+            this->storageContents = new StorageContentsLayout();
+            this->storageContents->SetOnInput(std::bind(&MainApplication::storageContents_Input, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+            this->AddBaseElements(this->storageContents);
+        }
         return this->storageContents;
     }
 
     ContentManagerLayout *MainApplication::GetContentManagerLayout()
     {
+        if(this->contentManager == NULL)
+        {
+            this->contentManager = new ContentManagerLayout();
+            this->contentManager->SetOnInput(std::bind(&MainApplication::contentManager_Input, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+            this->AddBaseElements(this->contentManager);
+        }
         return this->contentManager;
     }
 
     TitleDumperLayout *MainApplication::GetTitleDumperLayout()
     {
+        if(this->titleDump == NULL)
+        {
+            this->titleDump = new TitleDumperLayout();
+            this->AddBaseElements(this->titleDump);
+        }
         return this->titleDump;
     }
 
     TicketManagerLayout *MainApplication::GetTicketManagerLayout()
     {
+        if(this->ticketManager == NULL)
+        {
+            this->ticketManager = new TicketManagerLayout();
+            this->ticketManager->SetOnInput(std::bind(&MainApplication::ticketManager_Input, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+            this->AddBaseElements(this->ticketManager);
+        }
         return this->ticketManager;
     }
 
     AccountLayout *MainApplication::GetAccountLayout()
     {
+        if(this->account == NULL)
+        {
+            this->account = new AccountLayout();
+            this->account->SetOnInput(std::bind(&MainApplication::account_Input, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+            this->AddBaseElements(this->account);
+        }
         return this->account;
     }
 
     SystemInfoLayout *MainApplication::GetSystemInfoLayout()
     {
+        if(this->sysInfo == NULL)
+        {
+            this->sysInfo = new SystemInfoLayout();
+            this->sysInfo->SetOnInput(std::bind(&MainApplication::sysInfo_Input, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+            this->AddBaseElements(this->sysInfo);
+        }
         return this->sysInfo;
     }
 
     UpdateLayout *MainApplication::GetUpdateLayout()
     {
+        if(this->update == NULL)
+        {
+            this->update = new UpdateLayout();
+            this->AddBaseElements(this->update);
+        }
         return this->update;
     }
 
     AboutLayout *MainApplication::GetAboutLayout()
     {
+        if(this->about == NULL)
+        {
+            this->about = new AboutLayout();
+            this->about->SetOnInput(std::bind(&MainApplication::about_Input, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+            this->AddBaseElements(this->about);
+        }
         return this->about;
     }
 
+    VerifyLayout *MainApplication::GetVerifyLayout()
+    {
+        if(this->verify == NULL)
+        {
+            this->verify = new VerifyLayout();
+            this->AddBaseElements(this->verify);
+        }
+        return this->verify;
+    }
+
     void UpdateClipboard(std::string Path)
     {
         SetClipboard(Path);
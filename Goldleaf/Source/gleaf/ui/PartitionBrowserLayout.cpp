@@ -9,7 +9,7 @@ namespace gleaf::ui
     PartitionBrowserLayout::PartitionBrowserLayout() : pu::Layout()
     {
         this->gexp = fs::GetSdCardExplorer();
-        this->browseMenu = new pu::element::Menu(0, 160, 1280, gsets.CustomScheme.Base, gsets.MenuItemSize, (560 / gsets.MenuItemSize));
+        this->browseMenu = new VirtualMenu(0, 160, 1280, gsets.CustomScheme.Base, gsets.MenuItemSize, (560 / gsets.MenuItemSize));
         this->browseMenu->SetOnFocusColor(gsets.CustomScheme.BaseFocus);
         this->dirEmptyText = new pu::element::TextBlock(30, 630, set::GetDictionaryEntry(49));
         this->dirEmptyText->SetHorizontalAlign(pu::element::HorizontalAlign::Center);
@@ -59,11 +59,27 @@ namespace gleaf::ui
         if(Update) this->UpdateElements();
     }
 
+    void PartitionBrowserLayout::ChangePartitionHTTP(std::string URL, bool Update)
+    {
+        this->gexp = fs::GetHTTPExplorer(URL);
+        if(Update) this->UpdateElements();
+    }
+
+    void PartitionBrowserLayout::ChangePartitionExplorer(fs::Explorer *Exp, bool Update)
+    {
+        this->gexp = Exp;
+        if(Update) this->UpdateElements();
+    }
+
     void PartitionBrowserLayout::UpdateElements()
     {
         if(!this->elems.empty()) this->elems.clear();
         this->elems = this->gexp->GetContents();
-        this->browseMenu->ClearItems();
+        MenuDataSource src;
+        src.GetCount = [this]() -> u32 { return this->elems.size(); };
+        src.GetItem = std::bind(&PartitionBrowserLayout::CreateItem, this, std::placeholders::_1);
+        src.GetIcon = std::bind(&PartitionBrowserLayout::GetItemIcon, this, std::placeholders::_1);
+        this->browseMenu->SetDataSource(src);
         mainapp->LoadMenuHead(this->gexp->GetPresentableCwd());
         if(this->elems.empty())
         {
@@ -74,34 +90,38 @@ namespace gleaf::ui
         {
             this->browseMenu->SetVisible(true);
             this->dirEmptyText->SetVisible(false);
-            for(u32 i = 0; i < this->elems.size(); i++)
-            {
-                std::string itm = this->elems[i];
-                bool isdir = this->gexp->IsDirectory(itm);
-                pu::element::MenuItem *mitm = new pu::element::MenuItem(itm);
-                mitm->SetColor(gsets.CustomScheme.Text);
-                if(isdir) mitm->SetIcon(gsets.PathForResource("/FileSystem/Directory.png"));
-                else
-                {
-                    std::string ext = fs::GetExtension(itm);
-                    if(ext == "nsp") mitm->SetIcon(gsets.PathForResource("/FileSystem/NSP.png"));
-                    else if(ext == "nro") mitm->SetIcon(gsets.PathForResource("/FileSystem/NRO.png"));
-                    else if(ext == "tik") mitm->SetIcon(gsets.PathForResource("/FileSystem/TIK.png"));
-                    else if(ext == "cert") mitm->SetIcon(gsets.PathForResource("/FileSystem/CERT.png"));
-                    else if(ext == "nxtheme") mitm->SetIcon(gsets.PathForResource("/FileSystem/NXTheme.png"));
-                    else if(ext == "nca") mitm->SetIcon(gsets.PathForResource("/FileSystem/NCA.png"));
-                    else if(ext == "nacp") mitm->SetIcon(gsets.PathForResource("/FileSystem/NACP.png"));
-                    else if((ext == "jpg") || (ext == "jpeg")) mitm->SetIcon(gsets.PathForResource("/FileSystem/JPEG.png"));
-                    else mitm->SetIcon(gsets.PathForResource("/FileSystem/File.png"));
-                }
-                mitm->AddOnClick(std::bind(&PartitionBrowserLayout::fsItems_Click, this));
-                mitm->AddOnClick(std::bind(&PartitionBrowserLayout::fsItems_Click_Y, this), KEY_Y);
-                this->browseMenu->AddItem(mitm);
-            }
             this->browseMenu->SetSelectedIndex(0);
         }
     }
 
+    pu::element::MenuItem *PartitionBrowserLayout::CreateItem(u32 Index)
+    {
+        if(Index >= this->elems.size()) return NULL;
+        std::string itm = this->elems[Index];
+        pu::element::MenuItem *mitm = new pu::element::MenuItem(itm);
+        mitm->SetColor(gsets.CustomScheme.Text);
+        mitm->AddOnClick(std::bind(&PartitionBrowserLayout::fsItems_Click, this));
+        mitm->AddOnClick(std::bind(&PartitionBrowserLayout::fsItems_Click_Y, this), KEY_Y);
+        return mitm;
+    }
+
+    std::string PartitionBrowserLayout::GetItemIcon(u32 Index)
+    {
+        if(Index >= this->elems.size()) return "";
+        std::string itm = this->elems[Index];
+        if(this->gexp->IsDirectory(itm)) return gsets.PathForResource("/FileSystem/Directory.png");
+        std::string ext = fs::GetExtension(itm);
+        if(ext == "nsp") return gsets.PathForResource("/FileSystem/NSP.png");
+        else if(ext == "nro") return gsets.PathForResource("/FileSystem/NRO.png");
+        else if(ext == "tik") return gsets.PathForResource("/FileSystem/TIK.png");
+        else if(ext == "cert") return gsets.PathForResource("/FileSystem/CERT.png");
+        else if(ext == "nxtheme") return gsets.PathForResource("/FileSystem/NXTheme.png");
+        else if(ext == "nca") return gsets.PathForResource("/FileSystem/NCA.png");
+        else if(ext == "nacp") return gsets.PathForResource("/FileSystem/NACP.png");
+        else if((ext == "jpg") || (ext == "jpeg")) return gsets.PathForResource("/FileSystem/JPEG.png");
+        return gsets.PathForResource("/FileSystem/File.png");
+    }
+
     bool PartitionBrowserLayout::GoBack()
     {
         return this->gexp->NavigateBack();
@@ -109,6 +129,11 @@ namespace gleaf::ui
 
     bool PartitionBrowserLayout::WarnNANDWriteAccess()
     {
+        if(this->gexp->IsReadOnly())
+        {
+            mainapp->ShowNotification(set::GetDictionaryEntry(300));
+            return false;
+        }
         if(!this->gexp->ShouldWarnOnWriteAccess()) return true;
         int sopt = mainapp->CreateShowDialog(set::GetDictionaryEntry(50), set::GetDictionaryEntry(51), { set::GetDictionaryEntry(111), set::GetDictionaryEntry(18) }, true);
         return (sopt == 0);
@@ -124,14 +149,14 @@ namespace gleaf::ui
         {
             std::string ext = fs::GetExtension(itm);
             std::string msg = set::GetDictionaryEntry(52) + " ";
-            if(ext == "nsp") msg += set::GetDictionaryEntry(53);
-            else if(ext == "nro") msg += set::GetDictionaryEntry(54);
-            else if(ext == "tik") msg += set::GetDictionaryEntry(55);
-            else if(ext == "nxtheme") msg += set::GetDictionaryEntry(56);
-            else if(ext == "nca") msg += set::GetDictionaryEntry(57);
-            else if(ext == "nacp") msg += set::GetDictionaryEntry(58);
-            else if((ext == "jpg") || (ext == "jpeg")) msg += set::GetDictionaryEntry(59);
-            else msg += set::GetDictionaryEntry(270);
+            if(ext == "nsp") msg += set::GetDictionaryView(53);
+            else if(ext == "nro") msg += set::GetDictionaryView(54);
+            else if(ext == "tik") msg += set::GetDictionaryView(55);
+            else if(ext == "nxtheme") msg += set::GetDictionaryView(56);
+            else if(ext == "nca") msg += set::GetDictionaryView(57);
+            else if(ext == "nacp") msg += set::GetDictionaryView(58);
+            else if((ext == "jpg") || (ext == "jpeg")) msg += set::GetDictionaryView(59);
+            else msg += set::GetDictionaryView(270);
             msg += "\n\n" + set::GetDictionaryEntry(64) + " " + fs::FormatSize(this->gexp->GetFileSize(fullitm));
             std::vector<std::string> vopts;
             u32 copt = 5;
@@ -166,6 +191,11 @@ namespace gleaf::ui
                 vopts.push_back(set::GetDictionaryEntry(70));
                 copt = 6;
             }
+            else if(ext == "img")
+            {
+                vopts.push_back(set::GetDictionaryEntry(279));
+                copt = 6;
+            }
             else if(ext == "bin")
             {
                 if(IsAtmosphere())
@@ -205,7 +235,6 @@ namespace gleaf::ui
                         }
                         mainapp->LoadLayout(mainapp->GetInstallLayout());
                         mainapp->GetInstallLayout()->StartInstall(fullitm, this->gexp, dst, this);
-                        this->UpdateElements();
                         break;
                 }
             }
@@ -295,26 +324,26 @@ namespace gleaf::ui
                         msg += "\n" + set::GetDictionaryEntry(109) + " " + version;
                         msg += "\n" + set::GetDictionaryEntry(110) + " ";
                         u8 uacc = rnacp[0x3025];
-                        if(uacc == 0) msg += set::GetDictionaryEntry(112);
-                        else if(uacc == 1) msg += set::GetDictionaryEntry(111);
-                        else if(uacc == 2) msg += set::GetDictionaryEntry(113);
-                        else msg += set::GetDictionaryEntry(114);
+                        if(uacc == 0) msg += set::GetDictionaryView(112);
+                        else if(uacc == 1) msg += set::GetDictionaryView(111);
+                        else if(uacc == 2) msg += set::GetDictionaryView(113);
+                        else msg += set::GetDictionaryView(114);
                         u8 scrc = rnacp[0x3034];
                         msg += "\n" + set::GetDictionaryEntry(115) + " ";
-                        if(scrc == 0) msg += set::GetDictionaryEntry(111);
-                        else if(scrc == 1) msg += set::GetDictionaryEntry(112);
-                        else msg += set::GetDictionaryEntry(114);
+                        if(scrc == 0) msg += set::GetDictionaryView(111);
+                        else if(scrc == 1) msg += set::GetDictionaryView(112);
+                        else msg += set::GetDictionaryView(114);
                         u8 vidc = rnacp[0x3035];
                         msg += "\n" + set::GetDictionaryEntry(116) + " ";
-                        if(vidc == 0) msg += set::GetDictionaryEntry(112);
-                        else if(vidc == 1) msg += set::GetDictionaryEntry(117);
-                        else if(vidc == 2) msg += set::GetDictionaryEntry(111);
-                        else msg += set::GetDictionaryEntry(114);
+                        if(vidc == 0) msg += set::GetDictionaryView(112);
+                        else if(vidc == 1) msg += set::GetDictionaryView(117);
+                        else if(vidc == 2) msg += set::GetDictionaryView(111);
+                        else msg += set::GetDictionaryView(114);
                         u8 logom = rnacp[0x30f0];
                         msg += "\n" + set::GetDictionaryEntry(118) + " ";
-                        if(logom == 0) msg += set::GetDictionaryEntry(119);
-                        else if(logom == 2) msg += set::GetDictionaryEntry(120);
-                        else msg += set::GetDictionaryEntry(114);
+                        if(logom == 0) msg += set::GetDictionaryView(119);
+                        else if(logom == 2) msg += set::GetDictionaryView(120);
+                        else msg += set::GetDictionaryView(114);
                         mainapp->CreateShowDialog(set::GetDictionaryEntry(58), msg, { set::GetDictionaryEntry(234) }, false);
                         break;
                 }
@@ -358,6 +387,22 @@ namespace gleaf::ui
                         break;
                 }
             }
+            else if(ext == "img")
+            {
+                switch(sopt)
+                {
+                    case 0:
+                        fs::Explorer *fexp = fs::GetFatFsImageExplorer(fullitm, this->gexp);
+                        if(fexp == NULL)
+                        {
+                            mainapp->CreateShowDialog(set::GetDictionaryEntry(279), set::GetDictionaryEntry(280), { set::GetDictionaryEntry(234) }, true);
+                            return;
+                        }
+                        this->ChangePartitionExplorer(fexp);
+                        mainapp->LoadMenuData(itm, "Drive", fexp->GetPresentableCwd());
+                        return;
+                }
+            }
             else if(ext == "bin") 
             {
                 if(IsAtmosphere()) switch(sopt)
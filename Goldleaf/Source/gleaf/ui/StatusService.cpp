@@ -0,0 +1,96 @@
+#include <gleaf/ui/StatusService.hpp>
+#include <gleaf/horizon/Misc.hpp>
+#include <gleaf/usb/Communications.hpp>
+#include <unistd.h>
+
+namespace gleaf::ui
+{
+    static StatusSnapshot stsnap;
+    static bool stchanged = false;
+    static bool strunning = false;
+    static horizon::Thread *stthread = NULL;
+    static Mutex stlock;
+
+    static void PublishStatus(StatusSnapshot &Snapshot)
+    {
+        mutexLock(&stlock);
+        if((Snapshot.Time != stsnap.Time) || (Snapshot.BatteryLevel != stsnap.BatteryLevel) || (Snapshot.Charging != stsnap.Charging) || (Snapshot.USBPlugged != stsnap.USBPlugged) || (Snapshot.ConnectionStrength != stsnap.ConnectionStrength) || (Snapshot.IPAddress != stsnap.IPAddress))
+        {
+            stsnap = Snapshot;
+            stchanged = true;
+        }
+        mutexUnlock(&stlock);
+    }
+
+    static void StatusProcess(void *Args)
+    {
+        StatusSnapshot snap = {};
+        u64 tick = 0;
+        while(true)
+        {
+            mutexLock(&stlock);
+            bool run = strunning;
+            mutexUnlock(&stlock);
+            if(!run) break;
+            snap.Time = horizon::GetCurrentTime();
+            if((tick % 2) == 0) snap.USBPlugged = usb::IsStatePlugged();
+            if((tick % 8) == 0)
+            {
+                u32 connstr = 0;
+                Result rc = nifmGetInternetConnectionStatus(NULL, &connstr, NULL);
+                snap.ConnectionStrength = ((rc == 0) ? connstr : 0);
+                snap.IPAddress = ((snap.ConnectionStrength > 0) ? gethostid() : 0);
+            }
+            if((tick % 20) == 0)
+            {
+                snap.BatteryLevel = horizon::GetBatteryLevel();
+                snap.Charging = horizon::IsCharging();
+            }
+            PublishStatus(snap);
+            tick++;
+            svcSleepThread(250000000);
+        }
+    }
+
+    void StartStatusService()
+    {
+        mutexLock(&stlock);
+        if(strunning)
+        {
+            mutexUnlock(&stlock);
+            return;
+        }
+        strunning = true;
+        mutexUnlock(&stlock);
+        stthread = new horizon::Thread(&StatusProcess);
+        if(stthread->Start() != 0)
+        {
+            delete stthread;
+            stthread = NULL;
+            mutexLock(&stlock);
+            strunning = false;
+            mutexUnlock(&stlock);
+        }
+    }
+
+    void StopStatusService()
+    {
+        if(stthread == NULL) return;
+        mutexLock(&stlock);
+        strunning = false;
+        mutexUnlock(&stlock);
+        stthread->Join();
+        delete stthread;
+        stthread = NULL;
+    }
+
+    bool ConsumeStatusChanges(StatusSnapshot &Out)
+    {
+        mutexLock(&stlock);
+        bool chg = stchanged;
+        if(chg) Out = stsnap;
+        stchanged = false;
+        mutexUnlock(&stlock);
+        return chg;
+    }
+}
\ No newline at end of file
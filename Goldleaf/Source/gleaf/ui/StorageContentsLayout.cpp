@@ -8,8 +8,9 @@ namespace gleaf::ui
 
     StorageContentsLayout::StorageContentsLayout()
     {
-        this->contentsMenu = new pu::element::Menu(0, 160, 1280, gsets.CustomScheme.Base, gsets.MenuItemSize, (560 / gsets.MenuItemSize));
+        this->contentsMenu = new VirtualMenu(0, 160, 1280, gsets.CustomScheme.Base, gsets.MenuItemSize, (560 / gsets.MenuItemSize));
         this->contentsMenu->SetOnFocusColor(gsets.CustomScheme.BaseFocus);
+        this->contentsMenu->SetPlaceholderIcon(gsets.PathForResource("/Common/Storage.png"));
         this->noContentsText = new pu::element::TextBlock(0, 0, set::GetDictionaryEntry(188));
         this->noContentsText->SetHorizontalAlign(pu::element::HorizontalAlign::Center);
         this->noContentsText->SetVerticalAlign(pu::element::VerticalAlign::Center);
@@ -17,10 +18,15 @@ namespace gleaf::ui
         this->noContentsText->SetVisible(false);
         this->Add(this->noContentsText);
         this->Add(this->contentsMenu);
+        this->fetcher = NULL;
+        this->fetchcancel = false;
+        mutexInit(&this->fetchlock);
+        this->AddThread(std::bind(&StorageContentsLayout::UpdateControlData, this));
     }
 
     StorageContentsLayout::~StorageContentsLayout()
     {
+        this->StopFetch();
         delete this->noContentsText;
         delete this->contentsMenu;
     }
@@ -32,11 +38,82 @@ namespace gleaf::ui
         mainapp->LoadLayout(mainapp->GetContentInformationLayout());
     }
 
+    void StorageContentsLayout::FetchControlData(void *Args)
+    {
+        StorageContentsLayout *lyt = (StorageContentsLayout*)Args;
+        for(u32 i = 0; i < lyt->pending.size(); i++)
+        {
+            mutexLock(&lyt->fetchlock);
+            bool cancel = lyt->fetchcancel;
+            mutexUnlock(&lyt->fetchlock);
+            if(cancel) break;
+            u32 idx = lyt->pending[i];
+            lyt->contents[idx].DumpControlData();
+            mutexLock(&lyt->fetchlock);
+            lyt->fetched.push_back(idx);
+            mutexUnlock(&lyt->fetchlock);
+        }
+    }
+
+    void StorageContentsLayout::StopFetch()
+    {
+        if(this->fetcher == NULL) return;
+        mutexLock(&this->fetchlock);
+        this->fetchcancel = true;
+        mutexUnlock(&this->fetchlock);
+        this->fetcher->Join();
+        delete this->fetcher;
+        this->fetcher = NULL;
+        this->fetchcancel = false;
+        this->pending.clear();
+        this->fetched.clear();
+    }
+
+    void StorageContentsLayout::UpdateControlData()
+    {
+        if(this->fetcher == NULL) return;
+        std::vector<u32> upd;
+        mutexLock(&this->fetchlock);
+        upd.swap(this->fetched);
+        mutexUnlock(&this->fetchlock);
+        for(u32 i = 0; i < upd.size(); i++)
+        {
+            bool icon = false;
+            NacpStruct *nacp = this->contents[upd[i]].TryGetCachedNACP(&icon);
+            this->icons[upd[i]] = icon;
+            if(icon) InvalidateTexture(horizon::GetExportedIconPath(this->contents[upd[i]].ApplicationId));
+            if(nacp != NULL)
+            {
+                this->names[upd[i]] = horizon::GetNACPName(nacp);
+                free(nacp);
+            }
+            this->contentsMenu->InvalidateItem(upd[i]);
+        }
+    }
+
+    pu::element::MenuItem *StorageContentsLayout::CreateItem(u32 Index)
+    {
+        if(Index >= this->names.size()) return NULL;
+        pu::element::MenuItem *itm = new pu::element::MenuItem(this->names[Index]);
+        itm->SetColor(gsets.CustomScheme.Text);
+        itm->AddOnClick(std::bind(&StorageContentsLayout::contents_Click, this));
+        return itm;
+    }
+
+    std::string StorageContentsLayout::GetItemIcon(u32 Index)
+    {
+        if((Index >= this->contents.size()) || !this->icons[Index]) return "";
+        return horizon::GetExportedIconPath(this->contents[Index].ApplicationId);
+    }
+
     void StorageContentsLayout::LoadFromStorage(Storage Location)
     {
+        this->StopFetch();
+        CancelTextureDecodes();
         if(!this->contents.empty())
         {
-            this->contentsMenu->ClearItems();
+            this->names.clear();
+            this->icons.clear();
             this->contents.clear();
         }
         std::vector<horizon::Title> cnts = horizon::SearchTitles(ncm::ContentMetaType::Any, Location);
@@ -64,6 +141,11 @@ namespace gleaf::ui
             if(ok) this->contents.push_back(cnt);
         }
         cnts.clear();
+        MenuDataSource src;
+        src.GetCount = [this]() -> u32 { return this->names.size(); };
+        src.GetItem = std::bind(&StorageContentsLayout::CreateItem, this, std::placeholders::_1);
+        src.GetIcon = std::bind(&StorageContentsLayout::GetItemIcon, this, std::placeholders::_1);
+        this->contentsMenu->SetDataSource(src);
         if(this->contents.empty())
         {
             this->noContentsText->SetVisible(true);
@@ -71,24 +153,32 @@ namespace gleaf::ui
         }
         else
         {
-            this->contentsMenu->SetCooldownEnabled(true);
             this->noContentsText->SetVisible(false);
             this->contentsMenu->SetVisible(true);
             for(u32 i = 0; i < this->contents.size(); i++)
             {
-                NacpStruct *nacp = this->contents[i].TryGetNACP();
                 std::string name = horizon::FormatApplicationId(this->contents[i].ApplicationId);
+                bool icon = false;
+                NacpStruct *nacp = this->contents[i].TryGetCachedNACP(&icon);
+                bool cached = (nacp != NULL);
                 if(nacp != NULL)
                 {
                     name = horizon::GetNACPName(nacp);
                     free(nacp);
                 }
-                pu::element::MenuItem *itm = new pu::element::MenuItem(name);
-                itm->SetColor(gsets.CustomScheme.Text);
-                bool hicon = this->contents[i].DumpControlData();
-                if(hicon) itm->SetIcon(horizon::GetExportedIconPath(this->contents[i].ApplicationId));
-                itm->AddOnClick(std::bind(&StorageContentsLayout::contents_Click, this));
-                this->contentsMenu->AddItem(itm);
+                this->names.push_back(name);
+                this->icons.push_back(icon);
+                if(!cached) this->pending.push_back(i);
+            }
+            if(!this->pending.empty())
+            {
+                this->fetcher = new horizon::Thread(&StorageContentsLayout::FetchControlData);
+                if(this->fetcher->Start(this) != 0)
+                {
+                    delete this->fetcher;
+                    this->fetcher = NULL;
+                    this->pending.clear();
+                }
             }
             this->contentsMenu->SetSelectedIndex(0);
         }
@@ -0,0 +1,387 @@
+#include <gleaf/ui/TextureCache.hpp>
+#include <gleaf/horizon/TaskPool.hpp>
+#include <list>
+#include <map>
+#include <set>
+#include <sys/stat.h>
+
+namespace gleaf::ui
+{
+    struct CachedTexture
+    {
+        std::string Key;
+        std::string Path;
+        std::string Stamp;
+        pu::render::NativeTexture Texture;
+        u32 References;
+        u64 Size;
+    };
+
+    struct TextureDecode
+    {
+        std::string Key;
+        std::string Path;
+        u32 Width;
+        u32 Height;
+    };
+
+    struct DecodedSurface
+    {
+        SDL_Surface *Surface;
+        std::string Stamp;
+    };
+
+    static std::list<CachedTexture> texlru;
+    static std::map<std::string, std::list<CachedTexture>::iterator> texbykey;
+    static std::map<pu::render::NativeTexture, std::list<CachedTexture>::iterator> texbyptr;
+    static u64 texsize = 0;
+    static u64 texbudget = 0x1000000;
+    static Mutex texlock;
+    static std::set<std::string> decpending;
+    static std::set<std::string> decfailed;
+    static std::map<std::string, DecodedSurface> decready;
+
+    static std::string MakeTextureKey(std::string Path, u32 Width, u32 Height)
+    {
+        return (Path + ":" + std::to_string(Width) + "x" + std::to_string(Height));
+    }
+
+    // Taken once per load and kept with the texture; lookups never touch the file
+    static std::string MakeFileStamp(std::string Path)
+    {
+        struct stat st;
+        if(stat(Path.c_str(), &st) != 0) return "";
+        return (std::to_string(st.st_mtime) + ":" + std::to_string(st.st_size));
+    }
+
+    static std::list<CachedTexture>::iterator DestroyCachedTexture(std::list<CachedTexture>::iterator Entry)
+    {
+        SDL_DestroyTexture(Entry->Texture);
+        texsize -= Entry->Size;
+        if(!Entry->Key.empty()) texbykey.erase(Entry->Key);
+        texbyptr.erase(Entry->Texture);
+        return texlru.erase(Entry);
+    }
+
+    static void TrimTextureCache(u64 Budget)
+    {
+        auto it = texlru.end();
+        while((texsize > Budget) && (it != texlru.begin()))
+        {
+            it--;
+            if(it->References > 0) continue;
+            it = DestroyCachedTexture(it);
+        }
+    }
+
+    static SDL_Surface *LoadSurface(std::string Path, u32 Width, u32 Height)
+    {
+        SDL_Surface *sf = IMG_Load(Path.c_str());
+        if(sf == NULL) return NULL;
+        if((Width > 0) && (Height > 0) && ((sf->w != (int)Width) || (sf->h != (int)Height)))
+        {
+            SDL_Surface *ssf = SDL_CreateRGBSurfaceWithFormat(0, Width, Height, 32, SDL_PIXELFORMAT_RGBA32);
+            if(ssf != NULL)
+            {
+                SDL_SetSurfaceBlendMode(sf, SDL_BLENDMODE_NONE);
+                SDL_BlitScaled(sf, NULL, ssf, NULL);
+                SDL_FreeSurface(sf);
+                sf = ssf;
+            }
+        }
+        return sf;
+    }
+
+    static pu::render::NativeTexture UploadTexture(std::string Key, std::string Path, std::string Stamp, SDL_Surface *Surface)
+    {
+        pu::render::NativeTexture tex = SDL_CreateTextureFromSurface(pu::render::GetMainRenderer(), Surface);
+        SDL_FreeSurface(Surface);
+        if(tex == NULL) return NULL;
+        CachedTexture ctex;
+        ctex.Key = Key;
+        ctex.Path = Path;
+        ctex.Stamp = Stamp;
+        ctex.Texture = tex;
+        ctex.References = 1;
+        ctex.Size = ((u64)pu::render::GetTextureWidth(tex) * pu::render::GetTextureHeight(tex) * 4);
+        texlru.push_front(ctex);
+        texbykey[Key] = texlru.begin();
+        texbyptr[tex] = texlru.begin();
+        texsize += ctex.Size;
+        TrimTextureCache(texbudget);
+        return tex;
+    }
+
+    static pu::render::NativeTexture AcquireCachedTexture(std::string Key)
+    {
+        auto it = texbykey.find(Key);
+        if(it == texbykey.end()) return NULL;
+        texlru.splice(texlru.begin(), texlru, it->second);
+        it->second->References++;
+        return it->second->Texture;
+    }
+
+    static void DecodeTexture(TextureDecode Decode)
+    {
+        mutexLock(&texlock);
+        bool wanted = ((decpending.find(Decode.Key) != decpending.end()) && (decready.find(Decode.Key) == decready.end()));
+        mutexUnlock(&texlock);
+        if(!wanted) return;
+        std::string stamp = MakeFileStamp(Decode.Path);
+        SDL_Surface *sf = LoadSurface(Decode.Path, Decode.Width, Decode.Height);
+        mutexLock(&texlock);
+        if((decpending.find(Decode.Key) != decpending.end()) && (decready.find(Decode.Key) == decready.end())) decready[Decode.Key] = { sf, stamp };
+        else if(sf != NULL) SDL_FreeSurface(sf);
+        mutexUnlock(&texlock);
+    }
+
+    pu::render::NativeTexture AcquireTexture(std::string Path, u32 Width, u32 Height)
+    {
+        std::string key = MakeTextureKey(Path, Width, Height);
+        mutexLock(&texlock);
+        pu::render::NativeTexture tex = AcquireCachedTexture(key);
+        if(tex == NULL)
+        {
+            std::string stamp = MakeFileStamp(Path);
+            SDL_Surface *sf = LoadSurface(Path, Width, Height);
+            if(sf != NULL) tex = UploadTexture(key, Path, stamp, sf);
+        }
+        mutexUnlock(&texlock);
+        return tex;
+    }
+
+    pu::render::NativeTexture AcquireTextureAsync(std::string Path, u32 Width, u32 Height)
+    {
+        std::string key = MakeTextureKey(Path, Width, Height);
+        mutexLock(&texlock);
+        pu::render::NativeTexture tex = AcquireCachedTexture(key);
+        if(tex != NULL)
+        {
+            mutexUnlock(&texlock);
+            return tex;
+        }
+        auto rit = decready.find(key);
+        if(rit != decready.end())
+        {
+            DecodedSurface dsf = rit->second;
+            decready.erase(rit);
+            decpending.erase(key);
+            if(dsf.Surface != NULL) tex = UploadTexture(key, Path, dsf.Stamp, dsf.Surface);
+            if(tex == NULL) decfailed.insert(key);
+            mutexUnlock(&texlock);
+            return tex;
+        }
+        if((decpending.find(key) != decpending.end()) || (decfailed.find(key) != decfailed.end()))
+        {
+            mutexUnlock(&texlock);
+            return NULL;
+        }
+        decpending.insert(key);
+        mutexUnlock(&texlock);
+        // Decodes run on the shared task pool, several at once; only the upload stays on the render thread
+        TextureDecode dec = { key, Path, Width, Height };
+        horizon::SubmitTask(std::bind(&DecodeTexture, dec));
+        return NULL;
+    }
+
+    void CancelTextureDecodes()
+    {
+        mutexLock(&texlock);
+        decpending.clear();
+        for(auto &ready: decready) if(ready.second.Surface != NULL) SDL_FreeSurface(ready.second.Surface);
+        decready.clear();
+        decfailed.clear();
+        mutexUnlock(&texlock);
+    }
+
+    void ForgetTextureDecode(std::string Path, u32 Width, u32 Height)
+    {
+        std::string key = MakeTextureKey(Path, Width, Height);
+        mutexLock(&texlock);
+        decpending.erase(key);
+        decfailed.erase(key);
+        auto rit = decready.find(key);
+        if(rit != decready.end())
+        {
+            if(rit->second.Surface != NULL) SDL_FreeSurface(rit->second.Surface);
+            decready.erase(rit);
+        }
+        mutexUnlock(&texlock);
+    }
+
+    void InvalidateTexture(std::string Path)
+    {
+        std::string stamp = MakeFileStamp(Path);
+        mutexLock(&texlock);
+        for(auto it = texlru.begin(); it != texlru.end();)
+        {
+            if((it->Path != Path) || it->Key.empty() || (it->Stamp == stamp))
+            {
+                it++;
+                continue;
+            }
+            if(it->References == 0)
+            {
+                it = DestroyCachedTexture(it);
+                continue;
+            }
+            // Still drawn somewhere: unreachable for new lookups, destroyed with its last reference
+            texbykey.erase(it->Key);
+            it->Key.clear();
+            it++;
+        }
+        std::string prefix = (Path + ":");
+        for(auto it = decfailed.begin(); it != decfailed.end();)
+        {
+            if(it->compare(0, prefix.length(), prefix) == 0) it = decfailed.erase(it);
+            else it++;
+        }
+        mutexUnlock(&texlock);
+    }
+
+    void ReleaseTexture(pu::render::NativeTexture Texture)
+    {
+        if(Texture == NULL) return;
+        mutexLock(&texlock);
+        auto it = texbyptr.find(Texture);
+        if(it != texbyptr.end())
+        {
+            if(it->second->References > 0) it->second->References--;
+            if((it->second->References == 0) && it->second->Key.empty()) DestroyCachedTexture(it->second);
+            else TrimTextureCache(texbudget);
+        }
+        mutexUnlock(&texlock);
+    }
+
+    void SetTextureCacheBudget(u64 Bytes)
+    {
+        mutexLock(&texlock);
+        texbudget = Bytes;
+        TrimTextureCache(texbudget);
+        mutexUnlock(&texlock);
+    }
+
+    u64 GetTextureCacheSize()
+    {
+        mutexLock(&texlock);
+        u64 sz = texsize;
+        mutexUnlock(&texlock);
+        return sz;
+    }
+
+    void ClearTextureCache()
+    {
+        CancelTextureDecodes();
+        mutexLock(&texlock);
+        TrimTextureCache(0);
+        mutexUnlock(&texlock);
+    }
+
+    CachedImage::CachedImage(u32 X, u32 Y, std::string Image) : pu::element::Element::Element()
+    {
+        this->x = X;
+        this->y = Y;
+        this->w = 0;
+        this->h = 0;
+        this->ntex = NULL;
+        this->inatlas = false;
+        this->SetImage(Image);
+    }
+
+    CachedImage::~CachedImage()
+    {
+        ReleaseTexture(this->ntex);
+        this->ntex = NULL;
+    }
+
+    u32 CachedImage::GetX()
+    {
+        return this->x;
+    }
+
+    void CachedImage::SetX(u32 X)
+    {
+        this->x = X;
+    }
+
+    u32 CachedImage::GetY()
+    {
+        return this->y;
+    }
+
+    void CachedImage::SetY(u32 Y)
+    {
+        this->y = Y;
+    }
+
+    u32 CachedImage::GetWidth()
+    {
+        return this->w;
+    }
+
+    void CachedImage::SetWidth(u32 Width)
+    {
+        this->w = Width;
+    }
+
+    u32 CachedImage::GetHeight()
+    {
+        return this->h;
+    }
+
+    void CachedImage::SetHeight(u32 Height)
+    {
+        this->h = Height;
+    }
+
+    std::string CachedImage::GetImage()
+    {
+        return this->img;
+    }
+
+    void CachedImage::SetImage(std::string Image)
+    {
+        if((Image == this->img) && ((this->ntex != NULL) || this->inatlas)) return;
+        AtlasIcon aic;
+        if(FindAtlasIcon(Image, aic))
+        {
+            // Switching between atlas icons only swaps the source rectangle
+            ReleaseTexture(this->ntex);
+            this->ntex = NULL;
+            this->aicon = aic;
+            this->inatlas = true;
+            this->img = Image;
+            if((this->w == 0) && (this->h == 0))
+            {
+                this->w = aic.Source.w;
+                this->h = aic.Source.h;
+            }
+            return;
+        }
+        this->inatlas = false;
+        pu::render::NativeTexture ntex = AcquireTexture(Image);
+        ReleaseTexture(this->ntex);
+        this->ntex = ntex;
+        this->img = Image;
+        if((this->ntex != NULL) && (this->w == 0) && (this->h == 0))
+        {
+            this->w = pu::render::GetTextureWidth(this->ntex);
+            this->h = pu::render::GetTextureHeight(this->ntex);
+        }
+    }
+
+    bool CachedImage::IsImageValid()
+    {
+        return ((this->ntex != NULL) || this->inatlas);
+    }
+
+    void CachedImage::OnRender(pu::render::Renderer *Drawer)
+    {
+        if(this->inatlas) RenderAtlasIcon(this->aicon, this->x, this->y, this->w, this->h);
+        else if(this->ntex != NULL) Drawer->RenderTextureScaled(this->ntex, this->x, this->y, this->w, this->h);
+    }
+
+    void CachedImage::OnInput(u64 Down, u64 Up, u64 Held, bool Touch, bool Focus)
+    {
+    }
+}
\ No newline at end of file
@@ -63,7 +63,7 @@ namespace gleaf::ui
         info += set::GetDictionaryEntry(90) + " " + horizon::FormatApplicationId(tappid);
         info += "\n" + set::GetDictionaryEntry(95) + " " + std::to_string(seltick.GetKeyGeneration() + 1);
         info += "\n\n";
-        info += set::GetDictionaryEntry(203);
+        info += set::GetDictionaryView(203);
         int sopt = mainapp->CreateShowDialog(set::GetDictionaryEntry(200), info, { set::GetDictionaryEntry(245), set::GetDictionaryEntry(18) }, true);
         if(sopt < 0) return;
         sopt = mainapp->CreateShowDialog(set::GetDictionaryEntry(200), set::GetDictionaryEntry(204), { set::GetDictionaryEntry(111), set::GetDictionaryEntry(18) }, true);
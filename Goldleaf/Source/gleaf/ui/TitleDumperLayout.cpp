@@ -8,7 +8,7 @@ namespace gleaf::ui
 
     TitleDumperLayout::TitleDumperLayout()
     {
-        this->dumpText = new pu::element::TextBlock(150, 320, set::GetDictionaryEntry(151));
+        this->dumpText = new AtlasText(150, 320, set::GetDictionaryEntry(151));
         this->dumpText->SetHorizontalAlign(pu::element::HorizontalAlign::Center);
         this->dumpText->SetColor(gsets.CustomScheme.Text);
         this->ncaBar = new pu::element::ProgressBar(340, 360, 600, 30, 100.0f);
@@ -23,55 +23,44 @@ namespace gleaf::ui
         delete this->ncaBar;
     }
 
-    void TitleDumperLayout::StartDump(horizon::Title &Target)
+    static Result DumpTitle(horizon::Title Target, Job &Self)
     {
-        EnsureDirectories();
-        mainapp->CallForRender();
+        Progress &prog = Self.GetProgress();
         FsStorageId stid = static_cast<FsStorageId>(Target.Location);
         std::string fappid = horizon::FormatApplicationId(Target.ApplicationId);
         std::string outdir = "sdmc:/goldleaf/dump/" + fappid;
         fs::CreateDirectory(outdir);
-        this->dumpText->SetText(set::GetDictionaryEntry(192));
-        mainapp->CallForRender();
+        Self.SetStatus(set::GetDictionaryEntry(192));
         std::string tkey = dump::GetTitleKeyData(Target.ApplicationId, true);
-        this->dumpText->SetText(set::GetDictionaryEntry(193));
-        mainapp->CallForRender();
+        Self.SetStatus(set::GetDictionaryEntry(193));
         NcmContentStorage cst;
         Result rc = ncmOpenContentStorage(stid, &cst);
         if(rc != 0)
         {
-            HandleResult(err::Make(err::ErrorDescription::CouldNotLocateTitleContents), set::GetDictionaryEntry(198));
-            mainapp->LoadLayout(mainapp->GetContentManagerLayout());
-            return;
+            return err::Make(err::ErrorDescription::CouldNotLocateTitleContents);
         }
         NcmContentMetaDatabase cmdb;
         rc = ncmOpenContentMetaDatabase(stid, &cmdb);
         if(rc != 0)
         {
-            HandleResult(err::Make(err::ErrorDescription::CouldNotLocateTitleContents), set::GetDictionaryEntry(198));
-            mainapp->LoadLayout(mainapp->GetContentManagerLayout());
             serviceClose(&cst.s);
-            return;
+            return err::Make(err::ErrorDescription::CouldNotLocateTitleContents);
         }
         NcmMetaRecord mrec;
         bool ok = dump::GetMetaRecord(&cmdb, Target.ApplicationId, &mrec);
         if(!ok)
         {
-            HandleResult(err::Make(err::ErrorDescription::CouldNotLocateTitleContents), set::GetDictionaryEntry(198));
-            mainapp->LoadLayout(mainapp->GetContentManagerLayout());
             serviceClose(&cst.s);
             serviceClose(&cmdb.s);
-            return;
+            return err::Make(err::ErrorDescription::CouldNotLocateTitleContents);
         }
         NcmNcaId meta;
         ok = dump::GetNCAId(&cmdb, &mrec, Target.ApplicationId, dump::NCAType::Meta, &meta);
         if(!ok)
         {
-            HandleResult(err::Make(err::ErrorDescription::CouldNotLocateTitleContents), set::GetDictionaryEntry(198));
-            mainapp->LoadLayout(mainapp->GetContentManagerLayout());
             serviceClose(&cst.s);
             serviceClose(&cmdb.s);
-            return;
+            return err::Make(err::ErrorDescription::CouldNotLocateTitleContents);
         }
         std::string smeta = dump::GetNCAIdPath(&cst, &meta);
         NcmNcaId program;
@@ -109,75 +98,39 @@ namespace gleaf::ui
         std::string xdata = sdata;
         if(stid == FsStorageId_SdCard)
         {
-            this->dumpText->SetText(set::GetDictionaryEntry(194));
+            Self.SetStatus(set::GetDictionaryEntry(194));
             xmeta = outdir + "/" + horizon::GetStringFromNCAId(meta) + ".cnmt.nca";
-            this->ncaBar->SetVisible(true);
-            dump::DecryptCopyNAX0ToNCA(&cst, meta, xmeta, [&](double Done, double Total)
-            {
-                this->ncaBar->SetMaxValue(Total);
-                this->ncaBar->SetProgress(Done);
-                mainapp->CallForRender();
-            });
-            this->ncaBar->SetVisible(false);
+            prog.Reset();
+            dump::DecryptCopyNAX0ToNCA(&cst, meta, xmeta, prog);
             if(hasprogram)
             {
                 xprogram = outdir + "/" + horizon::GetStringFromNCAId(program) + ".nca";
-                this->ncaBar->SetVisible(true);
-                dump::DecryptCopyNAX0ToNCA(&cst, program, xprogram, [&](double Done, double Total)
-                {
-                    this->ncaBar->SetMaxValue(Total);
-                    this->ncaBar->SetProgress(Done);
-                    mainapp->CallForRender();
-                });
-                this->ncaBar->SetVisible(false);
+                prog.Reset();
+                dump::DecryptCopyNAX0ToNCA(&cst, program, xprogram, prog);
             }
             if(hascontrol)
             {
                 xcontrol = outdir + "/" + horizon::GetStringFromNCAId(control) + ".nca";
-                this->ncaBar->SetVisible(true);
-                dump::DecryptCopyNAX0ToNCA(&cst, control, xcontrol, [&](double Done, double Total)
-                {
-                    this->ncaBar->SetMaxValue(Total);
-                    this->ncaBar->SetProgress(Done);
-                    mainapp->CallForRender();
-                });
-                this->ncaBar->SetVisible(false);
+                prog.Reset();
+                dump::DecryptCopyNAX0ToNCA(&cst, control, xcontrol, prog);
             }
             if(haslinfo)
             {
                 xlinfo = outdir + "/" + horizon::GetStringFromNCAId(linfo) + ".nca";
-                this->ncaBar->SetVisible(true);
-                dump::DecryptCopyNAX0ToNCA(&cst, linfo, xlinfo, [&](double Done, double Total)
-                {
-                    this->ncaBar->SetMaxValue(Total);
-                    this->ncaBar->SetProgress(Done);
-                    mainapp->CallForRender();
-                });
-                this->ncaBar->SetVisible(false);
+                prog.Reset();
+                dump::DecryptCopyNAX0ToNCA(&cst, linfo, xlinfo, prog);
             }
             if(hashoff)
             {
                 xhoff = outdir + "/" + horizon::GetStringFromNCAId(hoff) + ".nca";
-                this->ncaBar->SetVisible(true);
-                dump::DecryptCopyNAX0ToNCA(&cst, hoff, xhoff, [&](double Done, double Total)
-                {
-                    this->ncaBar->SetMaxValue(Total);
-                    this->ncaBar->SetProgress(Done);
-                    mainapp->CallForRender();
-                });
-                this->ncaBar->SetVisible(false);
+                prog.Reset();
+                dump::DecryptCopyNAX0ToNCA(&cst, hoff, xhoff, prog);
             }
             if(hasdata)
             {
                 xdata = outdir + "/" + horizon::GetStringFromNCAId(data) + ".nca";
-                this->ncaBar->SetVisible(true);
-                dump::DecryptCopyNAX0ToNCA(&cst, data, xdata, [&](double Done, double Total)
-                {
-                    this->ncaBar->SetMaxValue(Total);
-                    this->ncaBar->SetProgress(Done);
-                    mainapp->CallForRender();
-                });
-                this->ncaBar->SetVisible(false);
+                prog.Reset();
+                dump::DecryptCopyNAX0ToNCA(&cst, data, xdata, prog);
             }
         }
         else
@@ -187,108 +140,115 @@ namespace gleaf::ui
             else if(stid == FsStorageId_NandUser) nexp = fs::GetNANDUserExplorer();
             else
             {
-                HandleResult(err::Make(err::ErrorDescription::CouldNotLocateTitleContents), set::GetDictionaryEntry(198));
-                mainapp->LoadLayout(mainapp->GetContentManagerLayout());
                 serviceClose(&cst.s);
                 serviceClose(&cmdb.s);
-                return;
+                return err::Make(err::ErrorDescription::CouldNotLocateTitleContents);
             }
-            this->dumpText->SetText(set::GetDictionaryEntry(195));
+            Self.SetStatus(set::GetDictionaryEntry(195));
             xmeta = nexp->FullPathFor("Contents/" + xmeta.substr(15));
             std::string txmeta = outdir + "/" + horizon::GetStringFromNCAId(meta) + ".cnmt.nca";
-            this->ncaBar->SetVisible(true);
-            fs::CopyFileProgress(xmeta, txmeta, [&](u8 p)
-            {
-                this->ncaBar->SetProgress(p);
-                mainapp->CallForRender();
-            });
-            this->ncaBar->SetVisible(false);
+            prog.Reset();
+            if(rc == 0) rc = fs::CopyFileProgress(xmeta, txmeta, prog);
             xmeta = txmeta;
             if(hasprogram)
             {
                 xprogram = nexp->FullPathFor("Contents/" + xprogram.substr(15));
                 std::string txprogram = outdir + "/" + horizon::GetStringFromNCAId(program) + ".nca";
-                this->ncaBar->SetVisible(true);
-                fs::CopyFileProgress(xprogram, txprogram, [&](u8 p)
-                {
-                    this->ncaBar->SetProgress(p);
-                    mainapp->CallForRender();
-                });
-                this->ncaBar->SetVisible(false);
+                prog.Reset();
+                if(rc == 0) rc = fs::CopyFileProgress(xprogram, txprogram, prog);
                 xprogram = txprogram;
             }
             if(hascontrol)
             {
                 xcontrol = nexp->FullPathFor("Contents/" + xcontrol.substr(15));
                 std::string txcontrol = outdir + "/" + horizon::GetStringFromNCAId(control) + ".nca";
-                this->ncaBar->SetVisible(true);
-                fs::CopyFileProgress(xcontrol, txcontrol, [&](u8 p)
-                {
-                    this->ncaBar->SetProgress(p);
-                    mainapp->CallForRender();
-                });
-                this->ncaBar->SetVisible(false);
+                prog.Reset();
+                if(rc == 0) rc = fs::CopyFileProgress(xcontrol, txcontrol, prog);
                 xcontrol = txcontrol;
             }
             if(haslinfo)
             {
                 xlinfo = nexp->FullPathFor("Contents/" + xlinfo.substr(15));
                 std::string txlinfo = outdir + "/" + horizon::GetStringFromNCAId(linfo) + ".nca";
-                this->ncaBar->SetVisible(true);
-                fs::CopyFileProgress(xlinfo, txlinfo, [&](u8 p)
-                {
-                    this->ncaBar->SetProgress(p);
-                    mainapp->CallForRender();
-                });
-                this->ncaBar->SetVisible(false);
+                prog.Reset();
+                if(rc == 0) rc = fs::CopyFileProgress(xlinfo, txlinfo, prog);
                 xlinfo = txlinfo;
             }
             if(hashoff)
             {
                 xhoff = nexp->FullPathFor("Contents/" + xhoff.substr(15));
                 std::string txhoff = outdir + "/" + horizon::GetStringFromNCAId(hoff) + ".nca";
-                this->ncaBar->SetVisible(true);
-                fs::CopyFileProgress(xhoff, txhoff, [&](u8 p)
-                {
-                    this->ncaBar->SetProgress(p);
-                    mainapp->CallForRender();
-                });
-                this->ncaBar->SetVisible(false);
+                prog.Reset();
+                if(rc == 0) rc = fs::CopyFileProgress(xhoff, txhoff, prog);
                 xhoff = txhoff;
             }
             if(hasdata)
             {
                 xdata = nexp->FullPathFor("Contents/" + xdata.substr(15));
                 std::string txdata = outdir + "/" + horizon::GetStringFromNCAId(data) + ".nca";
-                this->ncaBar->SetVisible(true);
-                fs::CopyFileProgress(xdata, txdata, [&](u8 p)
-                {
-                    this->ncaBar->SetProgress(p);
-                    mainapp->CallForRender();
-                });
-                this->ncaBar->SetVisible(false);
+                prog.Reset();
+                if(rc == 0) rc = fs::CopyFileProgress(xdata, txdata, prog);
                 xdata = txdata;
             }
         }
         std::string fout = "sdmc:/goldleaf/dump/" + fappid + ".nsp";
-        this->ncaBar->SetVisible(true);
-        this->dumpText->SetText(set::GetDictionaryEntry(196));
-        int qi = nsp::BuildPFS(outdir, fout, [&](u8 p)
-        {
-            this->ncaBar->SetProgress(p);
-            mainapp->CallForRender();
-        });
-        ok = (qi == 0);
+        Self.SetStatus(set::GetDictionaryEntry(196));
+        prog.Reset();
+        int qi = 0;
+        if((rc == 0) && !Self.IsCancelled()) qi = nsp::BuildPFS(outdir, fout, prog);
+        serviceClose(&cst.s);
+        serviceClose(&cmdb.s);
         fs::DeleteDirectory("sdmc:/goldleaf/dump/temp");
         fs::DeleteDirectory(outdir);
-        if(ok) mainapp->ShowNotification(set::GetDictionaryEntry(197) + " '" + fout + "'");
-        else
+        if(Self.IsCancelled())
+        {
+            fs::DeleteFile(fout);
+            return err::Make(err::ErrorDescription::OperationCancelled);
+        }
+        if(rc != 0) return rc;
+        if(qi != 0)
         {
-            HandleResult(err::Make(err::ErrorDescription::CouldNotBuildNSP), set::GetDictionaryEntry(198));
             fs::DeleteDirectory("sdmc:/goldleaf/dump");
-            EnsureDirectories();
+            return err::Make(err::ErrorDescription::CouldNotBuildNSP);
         }
-        serviceClose(&cst.s);
-        serviceClose(&cmdb.s);
+        return 0;
+    }
+
+    void TitleDumperLayout::StartDump(horizon::Title &Target)
+    {
+        EnsureDirectories();
+        std::string fout = "sdmc:/goldleaf/dump/" + horizon::FormatApplicationId(Target.ApplicationId) + ".nsp";
+        auto job = QueueJob("Dump", std::bind(&DumpTitle, Target, std::placeholders::_1));
+        mainapp->WatchJob(job, this->dumpText, this->ncaBar, [fout](Job &Done)
+        {
+            if(Done.GetState() == JobState::Finished)
+            {
+                if(Done.GetResult() == 0) mainapp->ShowNotification(set::GetDictionaryEntry(197) + " '" + fout + "'");
+                else HandleResult(Done.GetResult(), set::GetDictionaryEntry(198));
+            }
+            if(Done.GetResult() != 0) EnsureDirectories();
+            mainapp->UnloadMenuData();
+            mainapp->LoadLayout(mainapp->GetMainMenuLayout());
+        });
+    }
+
+    void TitleDumperLayout::StartMove(horizon::Title &Target, Storage Destination)
+    {
+        auto job = QueueJob("Move", [Target, Destination](Job &Self) -> Result
+        {
+            Self.SetStatus(set::GetDictionaryEntry(290));
+            horizon::Title tit = Target;
+            return horizon::MoveTitle(tit, Destination, Self.GetProgress());
+        });
+        mainapp->WatchJob(job, this->dumpText, this->ncaBar, [](Job &Done)
+        {
+            if(Done.GetState() == JobState::Finished)
+            {
+                if(Done.GetResult() == 0) mainapp->ShowNotification(set::GetDictionaryEntry(291));
+                else HandleResult(Done.GetResult(), set::GetDictionaryEntry(292));
+            }
+            mainapp->UnloadMenuData();
+            mainapp->LoadLayout(mainapp->GetMainMenuLayout());
+        });
     }
 }
\ No newline at end of file
@@ -8,7 +8,7 @@ namespace gleaf::ui
 
     UpdateLayout::UpdateLayout()
     {
-        this->infoText = new pu::element::TextBlock(150, 320, "Utest");
+        this->infoText = new AtlasText(150, 320, "Utest");
         this->infoText->SetHorizontalAlign(pu::element::HorizontalAlign::Center);
         this->infoText->SetColor(gsets.CustomScheme.Text);
         this->downloadBar = new pu::element::ProgressBar(340, 360, 600, 30, 100.0f);
@@ -34,9 +34,14 @@ namespace gleaf::ui
         this->downloadBar->SetVisible(false);
         this->infoText->SetText("Accessing GitHub metadata for releases' information...");
         mainapp->CallForRender();
-        std::string js = net::RetrieveContent("https://api.github.com/repos/xortroll/goldleaf/releases", "application/json");
-        json j = json::parse(js);
-        std::string latestid = j[0]["tag_name"].get<std::string>();
+        std::string latestid;
+        if(!net::ParseLatestRelease(net::FetchReleases(true), latestid))
+        {
+            mainapp->CreateShowDialog("Update search", "Unable to access GitHub metadata for releases' information.", { "Ok" }, true);
+            mainapp->UnloadMenuData();
+            mainapp->LoadLayout(mainapp->GetMainMenuLayout());
+            return;
+        }
         this->infoText->SetText("Access completed (latest release version: v" + latestid);
         mainapp->CallForRender();
         Version latestv = Version::FromString(latestid);
@@ -52,89 +57,107 @@ namespace gleaf::ui
             {
                 std::string baseurl = "https://github.com/XorTroll/Goldleaf/releases/download/" + latestid + "/Goldleaf";
                 fs::CreateDirectory("sdmc:/switch/Goldleaf");
-                fs::DeleteFile("sdmc:/switch/Goldleaf/Goldleaf.nro");
-                this->infoText->SetText("Downloading latest release NRO...");
-                mainapp->CallForRender();
-                this->downloadBar->SetVisible(true);
-                net::RetrieveToFile(baseurl + ".nro", "sdmc:/switch/Goldleaf/Goldleaf.nro", [&](double Done, double Total)
+                auto job = QueueJob("Update", [baseurl](Job &Self) -> Result
                 {
-                    this->downloadBar->SetMaxValue(Total);
-                    this->downloadBar->SetProgress(Done);
-                    mainapp->CallForRender();
+                    Self.SetStatus("Downloading latest release NRO...");
+                    return net::RetrieveToFile(baseurl + ".nro", "sdmc:/switch/Goldleaf/Goldleaf.nro", Self.GetProgress());
                 });
-                this->downloadBar->SetVisible(false);
-                this->infoText->SetText("NRO downloaded fine.");
-                mainapp->CallForRender();
-                sopt = mainapp->CreateShowDialog("Update search", "Would you like to download and install the NSP too?", { "Yes", "Cancel" }, true);
-                if(sopt == 0)
+                mainapp->WatchJob(job, this->infoText, this->downloadBar, std::bind(&UpdateLayout::OnNRODownloaded, this, baseurl, std::placeholders::_1));
+                return;
+            }
+        }
+        else if(latestv.IsHigher(currentv))
+        {
+            mainapp->CreateShowDialog("Update search", "Weird version mismatch (Goldleaf's version is higher than the latest release's one)\nAre you sure this Goldleaf is the official one?", { "Ok" }, true);
+        }
+        mainapp->UnloadMenuData();
+        mainapp->LoadLayout(mainapp->GetMainMenuLayout());
+    }
+
+    void UpdateLayout::OnNRODownloaded(std::string BaseURL, Job &Done)
+    {
+        if(Done.GetState() == JobState::Cancelled)
+        {
+            this->FinishUpdate();
+            return;
+        }
+        if(Done.GetResult() != 0)
+        {
+            HandleResult(Done.GetResult(), "An error occurred while downloading the latest release NRO.");
+            this->FinishUpdate();
+            return;
+        }
+        int sopt = mainapp->CreateShowDialog("Update search", "Would you like to download and install the NSP too?", { "Yes", "Cancel" }, true);
+        if(sopt != 0)
+        {
+            mainapp->ShowNotification("Goldleaf has been updated. Please restart it to use the new one.");
+            this->FinishUpdate();
+            return;
+        }
+        std::string nspfile = "sdmc:/switch/Goldleaf/Goldleaf.nsp";
+        auto job = QueueJob("Update", [BaseURL, nspfile](Job &Self) -> Result
+        {
+            Self.SetStatus("Downloading latest release NSP...");
+            Result rc = net::RetrieveToFile(BaseURL + ".nsp", nspfile, Self.GetProgress());
+            if(rc != 0) return rc;
+            Storage olds[] = { Storage::SdCard, Storage::NANDUser };
+            for(u32 i = 0; i < 2; i++)
+            {
+                if(!horizon::ExistsTitle(ncm::ContentMetaType::Any, olds[i], GOLDLEAF_APPID)) continue;
+                Self.SetStatus("Removing old installation...");
+                auto titles = horizon::SearchTitles(ncm::ContentMetaType::Any, olds[i]);
+                for(u32 j = 0; j < titles.size(); j++)
                 {
-                    std::string nspfile = "sdmc:/switch/Goldleaf/Goldleaf.nsp";
-                    fs::DeleteFile(nspfile);
-                    this->infoText->SetText("Downloading latest release NSP...");
-                    mainapp->CallForRender();
-                    this->downloadBar->SetVisible(true);
-                    net::RetrieveToFile(baseurl + ".nsp", nspfile, [&](double Done, double Total)
-                    {
-                        this->downloadBar->SetMaxValue(Total);
-                        this->downloadBar->SetProgress(Done);
-                        mainapp->CallForRender();
-                    });
-                    this->downloadBar->SetVisible(false);
-                    this->infoText->SetText("NSP downloaded fine. Preparing to install it...");
-                    mainapp->CallForRender();
-                    if(horizon::ExistsTitle(ncm::ContentMetaType::Any, Storage::SdCard, GOLDLEAF_APPID))
-                    {
-                        this->infoText->SetText("Removing old installation...");
-                        mainapp->CallForRender();
-                        auto titles = horizon::SearchTitles(ncm::ContentMetaType::Any, Storage::SdCard);
-                        for(u32 i = 0; i < titles.size(); i++)
-                        {
-                            if(titles[i].ApplicationId == GOLDLEAF_APPID)
-                            {
-                                horizon::RemoveTitle(titles[i]);
-                                break;
-                            }
-                        }
-                    }
-                    else if(horizon::ExistsTitle(ncm::ContentMetaType::Any, Storage::NANDUser, GOLDLEAF_APPID))
-                    {
-                        this->infoText->SetText("Removing old installation...");
-                        mainapp->CallForRender();
-                        auto titles = horizon::SearchTitles(ncm::ContentMetaType::Any, Storage::NANDUser);
-                        for(u32 i = 0; i < titles.size(); i++)
-                        {
-                            if(titles[i].ApplicationId == GOLDLEAF_APPID)
-                            {
-                                horizon::RemoveTitle(titles[i]);
-                                break;
-                            }
-                        }
-                    }
-                    this->infoText->SetText("Starting installation...");
-                    mainapp->CallForRender();
-                    sopt = mainapp->CreateShowDialog(set::GetDictionaryEntry(77), set::GetDictionaryEntry(78), { set::GetDictionaryEntry(19), set::GetDictionaryEntry(79), set::GetDictionaryEntry(18) }, true);
-                    if(sopt < 0) return;
-                    Storage dst = Storage::SdCard;
-                    if(sopt == 0) dst = Storage::SdCard;
-                    else if(sopt == 1) dst = Storage::NANDUser;
-                    u64 fsize = fs::GetFileSize(nspfile);
-                    u64 rsize = fs::GetFreeSpaceForPartition(static_cast<fs::Partition>(dst));
-                    if(rsize < fsize)
+                    if(titles[j].ApplicationId == GOLDLEAF_APPID)
                     {
-                        HandleResult(err::Make(err::ErrorDescription::NotEnoughSize), set::GetDictionaryEntry(251));
-                        return;
+                        horizon::RemoveTitle(titles[j]);
+                        break;
                     }
-                    mainapp->LoadLayout(mainapp->GetInstallLayout());
-                    mainapp->GetInstallLayout()->StartInstall(nspfile, fs::GetSdCardExplorer(), dst, mainapp->GetMainMenuLayout());
-                    mainapp->ShowNotification("Goldleaf has been updated and reinstalled. Please restart it to use the new one.");
                 }
-                else mainapp->ShowNotification("Goldleaf has been updated. Please restart it to use the new one.");
+                break;
             }
+            return 0;
+        });
+        mainapp->WatchJob(job, this->infoText, this->downloadBar, std::bind(&UpdateLayout::OnNSPDownloaded, this, nspfile, std::placeholders::_1));
+    }
+
+    void UpdateLayout::OnNSPDownloaded(std::string NSP, Job &Done)
+    {
+        if(Done.GetState() == JobState::Cancelled)
+        {
+            this->FinishUpdate();
+            return;
         }
-        else if(latestv.IsHigher(currentv))
+        if(Done.GetResult() != 0)
         {
-            mainapp->CreateShowDialog("Update search", "Weird version mismatch (Goldleaf's version is higher than the latest release's one)\nAre you sure this Goldleaf is the official one?", { "Ok" }, true);
+            HandleResult(Done.GetResult(), "An error occurred while downloading the latest release NSP.");
+            this->FinishUpdate();
+            return;
+        }
+        int sopt = mainapp->CreateShowDialog(set::GetDictionaryEntry(77), set::GetDictionaryEntry(78), { set::GetDictionaryEntry(19), set::GetDictionaryEntry(79), set::GetDictionaryEntry(18) }, true);
+        if(sopt < 0)
+        {
+            this->FinishUpdate();
+            return;
+        }
+        Storage dst = Storage::SdCard;
+        if(sopt == 0) dst = Storage::SdCard;
+        else if(sopt == 1) dst = Storage::NANDUser;
+        u64 fsize = fs::GetFileSize(NSP);
+        u64 rsize = fs::GetFreeSpaceForPartition(static_cast<fs::Partition>(dst));
+        if(rsize < fsize)
+        {
+            HandleResult(err::Make(err::ErrorDescription::NotEnoughSize), set::GetDictionaryEntry(251));
+            this->FinishUpdate();
+            return;
         }
+        mainapp->UnloadMenuData();
+        mainapp->LoadLayout(mainapp->GetInstallLayout());
+        mainapp->GetInstallLayout()->StartInstall(NSP, fs::GetSdCardExplorer(), dst, mainapp->GetMainMenuLayout());
+    }
+
+    void UpdateLayout::FinishUpdate()
+    {
         mainapp->UnloadMenuData();
         mainapp->LoadLayout(mainapp->GetMainMenuLayout());
     }
@@ -0,0 +1,62 @@
+#include <gleaf/ui.hpp>
+
+extern gleaf::set::Settings gsets;
+
+namespace gleaf::ui
+{
+    extern MainApplication *mainapp;
+
+    VerifyLayout::VerifyLayout()
+    {
+        this->infoText = new AtlasText(150, 320, set::GetDictionaryEntry(282));
+        this->infoText->SetHorizontalAlign(pu::element::HorizontalAlign::Center);
+        this->infoText->SetColor(gsets.CustomScheme.Text);
+        this->verifyBar = new pu::element::ProgressBar(340, 360, 600, 30, 100.0f);
+        this->Add(this->infoText);
+        this->Add(this->verifyBar);
+    }
+
+    VerifyLayout::~VerifyLayout()
+    {
+        delete this->infoText;
+        delete this->verifyBar;
+    }
+
+    void VerifyLayout::StartVerify(pu::Layout *Prev)
+    {
+        auto res = std::make_shared<std::vector<horizon::ContentVerification>>();
+        auto job = QueueJob("Verify", [res](Job &Self) -> Result
+        {
+            Self.SetStatus(set::GetDictionaryEntry(282));
+            std::vector<horizon::Title> titles = horizon::SearchTitles(ncm::ContentMetaType::Any, Storage::SdCard);
+            std::vector<horizon::Title> ntitles = horizon::SearchTitles(ncm::ContentMetaType::Any, Storage::NANDUser);
+            titles.insert(titles.end(), ntitles.begin(), ntitles.end());
+            horizon::IntegrityScanner scan(titles);
+            *res = scan.Scan(Self.GetProgress());
+            if(Self.IsCancelled()) return err::Make(err::ErrorDescription::OperationCancelled);
+            return 0;
+        });
+        mainapp->WatchJob(job, this->infoText, this->verifyBar, [res, Prev](Job &Done)
+        {
+            if(Done.GetState() == JobState::Finished)
+            {
+                std::string msg;
+                u32 bad = 0;
+                for(auto &cnt: *res)
+                {
+                    if(cnt.Status == horizon::ContentIntegrity::Ok) continue;
+                    bad++;
+                    // Keep the dialog readable on a console full of broken titles
+                    if(bad > 8) continue;
+                    u8 type = static_cast<u8>(cnt.Type);
+                    msg += "\n" + horizon::FormatApplicationId(cnt.ApplicationId) + " - " + ((type <= 5) ? set::GetDictionaryEntry(163 + type) : "?") + ": ";
+                    msg += set::GetDictionaryEntry((cnt.Status == horizon::ContentIntegrity::HashMismatch) ? 285 : 286);
+                }
+                if(bad > 8) msg += "\n(+" + std::to_string(bad - 8) + ")";
+                if(bad == 0) mainapp->CreateShowDialog(set::GetDictionaryEntry(281), set::GetDictionaryEntry(283), { set::GetDictionaryEntry(234) }, true);
+                else mainapp->CreateShowDialog(set::GetDictionaryEntry(281), set::GetDictionaryEntry(284) + "\n" + msg, { set::GetDictionaryEntry(234) }, true);
+            }
+            mainapp->LoadLayout(Prev);
+        });
+    }
+}
\ No newline at end of file
@@ -0,0 +1,314 @@
+#include <gleaf/ui/VirtualMenu.hpp>
+
+namespace gleaf::ui
+{
+    VirtualMenu::VirtualMenu(u32 X, u32 Y, u32 Width, pu::draw::Color OptionColor, u32 ItemSize, u32 ItemsToShow) : pu::element::Element::Element()
+    {
+        this->x = X;
+        this->y = Y;
+        this->w = Width;
+        this->isize = ItemSize;
+        this->ishow = ItemsToShow;
+        this->fisel = 0;
+        this->isel = 0;
+        this->clr = OptionColor;
+        this->fcs = { 40, 40, 40, 255 };
+        this->scb = { 110, 110, 110, 255 };
+        this->src.GetCount = []() -> u32 { return 0; };
+        this->src.GetItem = [](u32 Index) -> pu::element::MenuItem* { return NULL; };
+        this->onselch = [](){};
+        this->hkey = 0;
+        this->hrepeat = false;
+        this->phicon = NULL;
+    }
+
+    VirtualMenu::~VirtualMenu()
+    {
+        this->ReloadItems();
+        ReleaseTexture(this->phicon);
+    }
+
+    u32 VirtualMenu::GetX()
+    {
+        return this->x;
+    }
+
+    u32 VirtualMenu::GetY()
+    {
+        return this->y;
+    }
+
+    u32 VirtualMenu::GetWidth()
+    {
+        return this->w;
+    }
+
+    u32 VirtualMenu::GetHeight()
+    {
+        return (this->isize * this->ishow);
+    }
+
+    void VirtualMenu::SetOnFocusColor(pu::draw::Color Color)
+    {
+        this->fcs = Color;
+    }
+
+    void VirtualMenu::SetScrollbarColor(pu::draw::Color Color)
+    {
+        this->scb = Color;
+    }
+
+    void VirtualMenu::SetPlaceholderIcon(std::string Icon)
+    {
+        ReleaseTexture(this->phicon);
+        u32 icsz = (this->isize - 20);
+        this->phicon = AcquireTexture(Icon, icsz, icsz);
+    }
+
+    void VirtualMenu::SetOnSelectionChanged(std::function<void()> Callback)
+    {
+        this->onselch = Callback;
+    }
+
+    void VirtualMenu::SetDataSource(MenuDataSource Source)
+    {
+        this->ReloadItems();
+        this->src = Source;
+        this->fisel = 0;
+        this->isel = 0;
+    }
+
+    void VirtualMenu::ReloadItems()
+    {
+        for(auto &row: this->rows) delete row.second;
+        this->rows.clear();
+        for(auto &icon: this->icons) ReleaseTexture(icon.second);
+        this->icons.clear();
+        this->aicons.clear();
+        this->waiting.clear();
+    }
+
+    void VirtualMenu::InvalidateItem(u32 Index)
+    {
+        this->Recycle(Index);
+    }
+
+    u32 VirtualMenu::GetCount()
+    {
+        return this->src.GetCount();
+    }
+
+    pu::element::MenuItem *VirtualMenu::GetSelectedItem()
+    {
+        if(this->isel >= this->GetCount()) return NULL;
+        return this->Materialize(this->isel);
+    }
+
+    u32 VirtualMenu::GetSelectedIndex()
+    {
+        return this->isel;
+    }
+
+    void VirtualMenu::SetSelectedIndex(u32 Index)
+    {
+        u32 count = this->GetCount();
+        if(count == 0)
+        {
+            this->isel = 0;
+            this->fisel = 0;
+            return;
+        }
+        this->isel = std::min(Index, (count - 1));
+        if(this->isel < this->fisel) this->fisel = this->isel;
+        else if(this->isel >= (this->fisel + this->ishow)) this->fisel = (this->isel - this->ishow + 1);
+        this->RecycleOutside();
+        this->onselch();
+    }
+
+    pu::element::MenuItem *VirtualMenu::Materialize(u32 Index)
+    {
+        auto it = this->rows.find(Index);
+        if(it != this->rows.end()) return it->second;
+        pu::element::MenuItem *itm = this->src.GetItem(Index);
+        if(itm == NULL) return NULL;
+        this->rows[Index] = itm;
+        if(this->src.GetIcon)
+        {
+            std::string icon = this->src.GetIcon(Index);
+            if(!icon.empty())
+            {
+                u32 icsz = (this->isize - 20);
+                AtlasIcon aic;
+                if(FindAtlasIcon(icon, aic)) this->aicons[Index] = aic;
+                else
+                {
+                    pu::render::NativeTexture itex = AcquireTextureAsync(icon, icsz, icsz);
+                    if(itex != NULL) this->icons[Index] = itex;
+                    else this->waiting[Index] = icon;
+                }
+            }
+        }
+        return itm;
+    }
+
+    void VirtualMenu::Recycle(u32 Index)
+    {
+        auto it = this->rows.find(Index);
+        if(it != this->rows.end())
+        {
+            delete it->second;
+            this->rows.erase(it);
+        }
+        auto iit = this->icons.find(Index);
+        if(iit != this->icons.end())
+        {
+            ReleaseTexture(iit->second);
+            this->icons.erase(iit);
+        }
+        this->aicons.erase(Index);
+        auto wit = this->waiting.find(Index);
+        if(wit != this->waiting.end())
+        {
+            ForgetTextureDecode(wit->second, (this->isize - 20), (this->isize - 20));
+            this->waiting.erase(wit);
+        }
+    }
+
+    void VirtualMenu::RecycleOutside()
+    {
+        std::vector<u32> old;
+        for(auto &row: this->rows)
+        {
+            if(row.first == this->isel) continue;
+            if((row.first < this->fisel) || (row.first >= (this->fisel + this->ishow))) old.push_back(row.first);
+        }
+        for(auto idx: old) this->Recycle(idx);
+    }
+
+    void VirtualMenu::MoveSelection(s32 Offset)
+    {
+        u32 count = this->GetCount();
+        if(count == 0) return;
+        s32 nsel = ((s32)this->isel + Offset);
+        if(nsel < 0) nsel = (count - 1);
+        else if(nsel >= (s32)count) nsel = 0;
+        this->SetSelectedIndex((u32)nsel);
+    }
+
+    void VirtualMenu::OnRender(pu::render::Renderer *Drawer)
+    {
+        u32 count = this->GetCount();
+        if(count == 0) return;
+        u32 last = std::min((this->fisel + this->ishow), count);
+        u32 cy = this->y;
+        for(u32 i = this->fisel; i < last; i++)
+        {
+            pu::element::MenuItem *itm = this->Materialize(i);
+            Drawer->RenderRectangleFill(((i == this->isel) ? this->fcs : this->clr), this->x, cy, this->w, this->isize);
+            if(itm != NULL)
+            {
+                u32 tx = (this->x + 25);
+                u32 icsz = (this->isize - 20);
+                auto wit = this->waiting.find(i);
+                if(wit != this->waiting.end())
+                {
+                    pu::render::NativeTexture itex = AcquireTextureAsync(wit->second, icsz, icsz);
+                    if(itex != NULL)
+                    {
+                        this->icons[i] = itex;
+                        this->waiting.erase(wit);
+                    }
+                    else
+                    {
+                        if(this->phicon != NULL) Drawer->RenderTexture(this->phicon, tx, (cy + 10));
+                        tx += (icsz + 25);
+                    }
+                }
+                auto ait = this->aicons.find(i);
+                auto iit = this->icons.find(i);
+                if(ait != this->aicons.end())
+                {
+                    RenderAtlasIcon(ait->second, tx, (cy + 10), icsz, icsz);
+                    tx += (icsz + 25);
+                }
+                else if(iit != this->icons.end())
+                {
+                    Drawer->RenderTexture(iit->second, tx, (cy + 10));
+                    tx += (icsz + 25);
+                }
+                else if(itm->HasIcon())
+                {
+                    Drawer->RenderTextureScaled(itm->GetIconTexture(), tx, (cy + 10), icsz, icsz);
+                    tx += (icsz + 25);
+                }
+                pu::render::NativeTexture ntex = itm->GetNameTexture();
+                u32 th = pu::render::GetTextureHeight(ntex);
+                Drawer->RenderTexture(ntex, tx, (cy + ((this->isize - th) / 2)));
+            }
+            cy += this->isize;
+        }
+        if(count > this->ishow)
+        {
+            u32 sch = this->GetHeight();
+            u32 bh = std::max((sch * this->ishow) / count, (u32)20);
+            u32 by = (this->y + (((sch - bh) * this->fisel) / (count - this->ishow)));
+            Drawer->RenderRectangleFill(this->scb, (this->x + this->w - 10), by, 10, bh);
+        }
+    }
+
+    void VirtualMenu::OnInput(u64 Down, u64 Up, u64 Held, bool Touch, bool Focus)
+    {
+        u32 count = this->GetCount();
+        if(count == 0) return;
+        if(Touch)
+        {
+            touchPosition tch;
+            hidTouchRead(&tch, 0);
+            if((tch.px >= this->x) && (tch.px < (this->x + this->w)) && (tch.py >= this->y) && (tch.py < (this->y + this->GetHeight())))
+            {
+                u32 tidx = (this->fisel + ((tch.py - this->y) / this->isize));
+                if(tidx < count)
+                {
+                    if(tidx == this->isel) Down |= KEY_A;
+                    else this->SetSelectedIndex(tidx);
+                }
+            }
+        }
+        if(Down & KEY_DOWN)
+        {
+            this->MoveSelection(1);
+            this->hkey = KEY_DOWN;
+            this->htp = std::chrono::steady_clock::now();
+            this->hrepeat = false;
+        }
+        else if(Down & KEY_UP)
+        {
+            this->MoveSelection(-1);
+            this->hkey = KEY_UP;
+            this->htp = std::chrono::steady_clock::now();
+            this->hrepeat = false;
+        }
+        else if((this->hkey != 0) && (Held & this->hkey))
+        {
+            auto now = std::chrono::steady_clock::now();
+            u64 diff = std::chrono::duration_cast<std::chrono::milliseconds>(now - this->htp).count();
+            if(diff >= (this->hrepeat ? 50 : 400))
+            {
+                this->MoveSelection((this->hkey == KEY_DOWN) ? 1 : -1);
+                this->htp = now;
+                this->hrepeat = true;
+            }
+        }
+        else this->hkey = 0;
+        pu::element::MenuItem *itm = this->GetSelectedItem();
+        if(itm == NULL) return;
+        for(u32 i = 0; i < itm->GetCallbackCount(); i++)
+        {
+            if(Down & itm->GetCallbackKey(i))
+            {
+                (itm->GetCallback(i))();
+                break;
+            }
+        }
+    }
+}
\ No newline at end of file